@@ -11,6 +11,8 @@
 extern "C" {
 #include <minIni.h>
 }
+#include <dclight/client/ipc.h>
+#include <dclight/client/mailbox.h>
 
 #include "slider.hpp"
 
@@ -63,11 +65,78 @@ void saveBrightness(int brightness) {
     
     if (result) {
         brls::Logger::info("亮度值已保存: {}", brightness);
+        // sysmodule 不再定时轮询配置文件，写入后通知它重新检查
+        if (dclightIpcIsActive()) {
+            dclightIpcReloadConfig();
+        }
     } else {
         brls::Logger::error("保存亮度值失败");
     }
 }
 
+// 连接 sysmodule 的控制服务和共享内存信箱；sysmodule 未运行时返回 false
+bool connectService() {
+    if (!dclightIpcIsActive()) {
+        if (!dclightIpcRunning()) {
+            return false;
+        }
+        Result rc = dclightIpcInitialize();
+        if (R_FAILED(rc)) {
+            brls::Logger::error("连接 DClight 服务失败: 0x{:X}", rc);
+            return false;
+        }
+    }
+
+    if (!dclightMailboxIsOpen()) {
+        Result rc = dclightMailboxOpen();
+        if (R_FAILED(rc)) {
+            brls::Logger::error("共享内存信箱不可用，改用 IPC 命令: 0x{:X}", rc);
+        }
+    }
+    return true;
+}
+
+// 断开连接（sysmodule 重启后旧的信箱不再有效）
+void disconnectService() {
+    dclightMailboxClose();
+    if (dclightIpcIsActive()) {
+        dclightIpcExit();
+    }
+}
+
+// 实时调节：优先写共享内存信箱，其次走 IPC 命令，下一帧即可生效；
+// 持久化仍由 saveBrightness 写入 INI
+void applyBrightnessLive(int brightness) {
+    if (!connectService()) {
+        return;
+    }
+
+    Result rc;
+    if (dclightMailboxIsOpen()) {
+        rc = dclightMailboxSubmit(brightness, 0, 0);
+    } else {
+        rc = dclightIpcSetBrightness((u32)brightness);
+    }
+
+    if (R_FAILED(rc)) {
+        // sysmodule 可能已被停止，下次调节时重新连接
+        brls::Logger::error("实时设置亮度失败: 0x{:X}", rc);
+        disconnectService();
+    }
+}
+
+// 读取覆盖层当前生效的亮度；不可用时返回 -1
+int loadLiveBrightness() {
+    if (!connectService() || !dclightMailboxIsOpen()) {
+        return -1;
+    }
+    DClightMailboxStatus status;
+    if (!dclightMailboxReadStatus(&status)) {
+        return -1;
+    }
+    return status.brightness;
+}
+
 // 检测 sysmodule 是否在运行
 bool isSysmoduleRunning(u64 tid) {
     Result rc;
@@ -161,6 +230,7 @@ bool startSysmodule(u64 tid) {
 
 // 开关调光：在 DClight 和另一模块间切换
 void toggleDimming(bool enableDClight) {
+    disconnectService();
     if (enableDClight) {
         brls::Logger::info("正在启用 DClight 调光...");
         // 先停止另一个调光模块
@@ -245,8 +315,12 @@ int main(int argc, char* argv[]) {
     // 分隔线
     list->addView(new brls::Header("亮度设置"));
     
-    // 读取当前亮度
+    // 读取当前亮度：sysmodule 运行时以覆盖层实际生效的值为准
     int currentBrightness = loadBrightness();
+    int liveBrightness = loadLiveBrightness();
+    if (liveBrightness >= 0) {
+        currentBrightness = liveBrightness;
+    }
     
     // 亮度滑块
     brls::Slider* brightnessSlider = new brls::Slider(
@@ -260,6 +334,7 @@ int main(int argc, char* argv[]) {
     brightnessSlider->getValueEvent()->subscribe([](float value) {
         int brightness = (int)value;
         brls::Logger::info("亮度调节为: {}", brightness);
+        applyBrightnessLive(brightness);
         saveBrightness(brightness);
     });
     
@@ -285,6 +360,7 @@ int main(int argc, char* argv[]) {
     while (brls::Application::mainLoop());
 
     // 退出
+    disconnectService();
     socketExit();
     
     return EXIT_SUCCESS;
@@ -0,0 +1,31 @@
+/* DClight IPC 客户端：NRO 通过命名服务直接调节 sysmodule */
+#pragma once
+
+#include <switch.h>
+#include "../ipc.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+// 服务是否已由 sysmodule 注册（不会阻塞等待注册）
+bool dclightIpcRunning(void);
+Result dclightIpcInitialize(void);
+void dclightIpcExit(void);
+bool dclightIpcIsActive(void);
+
+Result dclightIpcGetApiVersion(u32* out_ver);
+Result dclightIpcGetBrightness(s32* out_brightness);
+Result dclightIpcSetBrightness(u32 brightness);
+Result dclightIpcGetAlpha(u32* out_alpha);
+Result dclightIpcSetAlpha(u32 alpha);
+Result dclightIpcGetStatus(DClightStatus* out_status);
+Result dclightIpcGetMailbox(Handle* out_shmem, Handle* out_doorbell);
+Result dclightIpcReloadConfig(void);
+Result dclightIpcGetMemoryStats(DClightMemoryStats* out_stats);
+Result dclightIpcGetBootTrace(DClightBootTrace* out_trace);
+Result dclightIpcGetMetrics(DClightMetrics* out_metrics);
+
+#if defined __cplusplus
+}
+#endif
@@ -0,0 +1,24 @@
+/* DClight 共享内存信箱客户端：NRO 写控制字并读取覆盖层状态，不经过 IPC 往返 */
+#pragma once
+
+#include <switch.h>
+#include "../mailbox.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+// 通过 IPC 获取信箱并映射（需先 dclightIpcInitialize）
+Result dclightMailboxOpen(void);
+void dclightMailboxClose(void);
+bool dclightMailboxIsOpen(void);
+
+// 提交新的目标值并敲 doorbell；brightness 为 DCLIGHT_BRIGHTNESS_NONE 时使用 alpha
+Result dclightMailboxSubmit(s32 brightness, u32 alpha, u32 ramp_ms);
+
+// 读取覆盖层发布的当前状态
+bool dclightMailboxReadStatus(DClightMailboxStatus* out_status);
+
+#if defined __cplusplus
+}
+#endif
@@ -0,0 +1,176 @@
+/* DClight IPC 协议：sysmodule 与 NRO（以及 Linux 上的替身服务）共用 */
+#pragma once
+
+#include <switch/types.h>
+#include <switch/result.h>
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#define DCLIGHT_IPC_SERVICE_NAME "dclight"
+#define DCLIGHT_IPC_API_VERSION  1
+#define DCLIGHT_IPC_MAX_SESSIONS 4
+
+#define DCLIGHT_ERROR_MODULE 389
+#define DCLIGHT_ERROR(desc) MAKERESULT(DCLIGHT_ERROR_MODULE, DClightError_##desc)
+
+typedef enum {
+    DClightError_Generic = 0,
+    DClightError_UnknownCommand = 1,
+    DClightError_InvalidArgument = 2,
+    DClightError_NotAvailable = 3,
+} DClightError;
+
+typedef enum {
+    DClightIpcCmd_GetApiVersion = 0,
+    DClightIpcCmd_GetBrightness = 1,
+    DClightIpcCmd_SetBrightness = 2,
+    DClightIpcCmd_GetAlpha = 3,
+    DClightIpcCmd_SetAlpha = 4,
+    DClightIpcCmd_GetStatus = 5,
+    DClightIpcCmd_GetMailbox = 6, // 返回共享内存信箱句柄和 doorbell 事件写端（见 mailbox.h）
+    DClightIpcCmd_ReloadConfig = 7, // 立即重新检查 config.ini（写入配置后调用，无需等待轮询）
+    DClightIpcCmd_GetMemoryStats = 8,
+    DClightIpcCmd_GetBootTrace = 9, // 启动各步骤的耗时（DClightBootTrace）
+    DClightIpcCmd_GetMetrics = 10,  // 运行时计数和耗时直方图（DClightMetrics）
+} DClightIpcCmd;
+
+#define DCLIGHT_BRIGHTNESS_MAX 100
+#define DCLIGHT_ALPHA_MAX      15
+
+// brightness 字段在亮度由 alpha 直接指定时为该值
+#define DCLIGHT_BRIGHTNESS_NONE (-1)
+// presented_alpha 字段在尚未提交任何帧时为该值
+#define DCLIGHT_ALPHA_NONE      0xFFFFFFFF
+
+// 亮度(0-100) -> 覆盖层 alpha(0-15)：100 不暗化，0 最暗
+static inline u32 dclightBrightnessToAlpha(u32 brightness) {
+    if (brightness > DCLIGHT_BRIGHTNESS_MAX) brightness = DCLIGHT_BRIGHTNESS_MAX;
+    return ((DCLIGHT_BRIGHTNESS_MAX - brightness) * DCLIGHT_ALPHA_MAX) / DCLIGHT_BRIGHTNESS_MAX;
+}
+
+// 亮度(0-100) -> 0-255 的 alpha（四舍五入）：8 位 alpha 的帧缓冲按它画出 16 级之间的亮度
+static inline u32 dclightBrightnessToAlpha8(u32 brightness) {
+    if (brightness > DCLIGHT_BRIGHTNESS_MAX) brightness = DCLIGHT_BRIGHTNESS_MAX;
+    return ((DCLIGHT_BRIGHTNESS_MAX - brightness) * 255 + DCLIGHT_BRIGHTNESS_MAX / 2) / DCLIGHT_BRIGHTNESS_MAX;
+}
+
+typedef enum {
+    DClightStatusFlag_GfxReady = BIT(0), // 覆盖层已初始化
+    DClightStatusFlag_FromIpc  = BIT(1), // 当前值来自 IPC（否则来自 config.ini）
+    DClightStatusFlag_Cmu      = BIT(2), // 通过显示器色彩管理暗化（没有覆盖层）
+} DClightStatusFlag;
+
+typedef struct {
+    u32 api_version;
+    s32 brightness;      // 当前亮度 0-100，或 DCLIGHT_BRIGHTNESS_NONE
+    u32 alpha;           // 当前目标 alpha 0-15
+    u32 presented_alpha; // 最近一次提交给合成器的 alpha，或 DCLIGHT_ALPHA_NONE
+    u32 flags;           // DClightStatusFlag
+    u32 config_reloads;  // config.ini 重新解析次数
+} DClightStatus;
+
+// sysmodule 的内存占用（字节）
+typedef struct {
+    u32 heap_size;          // 内部堆总大小
+    u32 heap_used;          // 当前已分配
+    u32 heap_peak;          // 堆的最高水位
+    u32 libnx_allocs;       // libnx 内部分配累计次数（NV transfer memory、帧缓冲、线程栈）
+    u32 libnx_live;         // 其中尚未释放的块数
+    u32 libnx_bytes;        // 其中尚未释放的字节数
+    u32 libnx_peak;         // libnx 内部分配的峰值
+    u32 nv_tmem_size;       // NV transfer memory
+    u32 framebuffer_bytes;  // 帧缓冲（nvmap）总大小
+    u32 framebuffer_count;  // 帧缓冲数量
+} DClightMemoryStats;
+
+// 启动步骤；GetBootTrace 按实际发生的顺序返回（快速启动时服务在第一帧之后才启动）
+typedef enum {
+    DClightBootStep_Heap = 0,    // __libnx_initheap：进程开始运行
+    DClightBootStep_Sm,          // smInitialize
+    DClightBootStep_Fs,          // fsInitialize
+    DClightBootStep_SdMount,     // fsdevMountSdmc
+    DClightBootStep_Log,         // 写日志线程启动
+    DClightBootStep_Hid,         // hidInitialize
+    DClightBootStep_Time,        // timeInitialize
+    DClightBootStep_ViInit,      // viInitialize
+    DClightBootStep_Display,     // 打开显示并取得 vsync 事件
+    DClightBootStep_Layer,       // 创建并设置图层（缩放、Z 序、图层栈、尺寸、位置）
+    DClightBootStep_Window,      // nwindowCreateFromLayer
+    DClightBootStep_Framebuffer, // framebufferCreate 和区域图层准备
+    DClightBootStep_Config,      // 第一次读取 config.ini
+    DClightBootStep_FirstFrame,  // 第一帧暗化已提交
+    DClightBootStep_Title,       // 应用监视
+    DClightBootStep_Mailbox,     // 共享内存信箱
+    DClightBootStep_Ipc,         // IPC 服务开始接受连接
+    DClightBootStep_FullConfig,  // 快速启动：第一帧之后解析完整配置
+    DClightBootStep_Ready,       // 启动完成，主循环进入空闲等待
+    DClightBootStep_Count,
+} DClightBootStep;
+
+#define DCLIGHT_BOOT_TRACE_MAX 20
+
+// 回复必须放进 TLS 中的 CMIF 回复，因此不带累计时间：某一步距进程开始运行的时间是它和之前各步 duration_us 之和
+typedef struct {
+    u16 step;        // DClightBootStep
+    u16 reserved;
+    u32 duration_us; // 距上一步的微秒数
+} DClightBootTraceEntry;
+
+typedef struct {
+    u32 count;       // entries 中有效的项数（启动过程中读取时只包含已完成的步骤）
+    u32 start_ms;    // 进程开始运行时距开机的毫秒数
+    DClightBootTraceEntry entries[DCLIGHT_BOOT_TRACE_MAX];
+} DClightBootTrace;
+
+static inline const char *dclightBootStepName(u32 step) {
+    static const char *const names[DClightBootStep_Count] = {
+        "heap", "sm", "fs", "sdmc", "log", "hid", "time", "vi", "display", "layer",
+        "window", "framebuffer", "config", "first-frame", "title", "mailbox", "ipc", "full-config", "ready",
+    };
+    return step < DClightBootStep_Count ? names[step] : "?";
+}
+
+// 耗时直方图：桶按 4 倍递增，第 i 个桶统计小于 dclightHistogramLimitUs(i) 微秒的样本，
+// 最后一个桶统计其余所有样本。样本数是各桶之和，不单独传输（DClightMetrics 要放进 TLS 中的 CMIF 回复）
+#define DCLIGHT_HISTOGRAM_BUCKETS 7
+
+typedef struct {
+    u64 total_us;  // 所有样本之和
+    u32 max_us;
+    u32 buckets[DCLIGHT_HISTOGRAM_BUCKETS];
+} DClightHistogram;
+
+// 第 bucket 个桶的上限（64us, 256us, ... 65.5ms）；最后一个桶没有上限，返回 0
+static inline u32 dclightHistogramLimitUs(u32 bucket) {
+    return bucket + 1 < DCLIGHT_HISTOGRAM_BUCKETS ? 64u << (2 * bucket) : 0;
+}
+
+static inline u32 dclightHistogramCount(const DClightHistogram *h) {
+    u32 count = 0;
+    for (u32 i = 0; i < DCLIGHT_HISTOGRAM_BUCKETS; ++i) count += h->buckets[i];
+    return count;
+}
+
+// 主循环的运行时统计；计数从进程启动起累计
+typedef struct {
+    u32 uptime_s;
+    u32 wakeups;            // 主循环醒来的次数
+    u32 wakeups_per_minute; // 最近一个完整的一分钟内醒来的次数
+    u32 frames_presented;   // 提交给合成器的帧（区域图层每层算一帧）
+    u32 frames_skipped;     // 主循环醒来但暗化等级未变、没有提交的次数
+    u32 config_checks;      // 配置文件元数据查询（打开、大小、时间戳）
+    u32 config_reads;       // 完整读取并解析 config.ini
+    u32 log_writes;         // 写日志文件的批次
+    u32 title_polls;        // 前台应用查询（pm 服务调用）
+    u32 reserved;
+    DClightHistogram config_reload; // 读取并解析 config.ini
+    DClightHistogram vsync_wait;    // 从开始等待到 vsync 到达
+    DClightHistogram fb_begin;      // framebufferBegin（出队缓冲）
+    DClightHistogram fb_end;        // framebufferEnd（入队缓冲）
+} DClightMetrics;
+
+#if defined __cplusplus
+}
+#endif
@@ -0,0 +1,110 @@
+/* DClight 共享内存信箱：NRO 与覆盖层之间最低延迟的调节通道
+ *
+ * 一页共享内存，分为两个方向，各自只有一个写者，用 seqlock 保护：
+ *   control: NRO 写，覆盖层读（亮度、alpha、过渡时长、generation）
+ *   status:  覆盖层写，NRO 读（当前生效的状态）
+ * 读写双方都不需要系统调用；NRO 写完后通过 doorbell 事件唤醒覆盖层。
+ */
+#pragma once
+
+#include <string.h>
+#include <switch/types.h>
+#include "ipc.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#define DCLIGHT_MAILBOX_MAGIC   0x4C424D44 // "DMBL"
+#define DCLIGHT_MAILBOX_VERSION 1
+#define DCLIGHT_MAILBOX_SIZE    0x1000
+
+typedef struct {
+    u32 seq;          // seqlock 序号，奇数表示正在写入
+    u32 generation;   // 每次提交 +1，覆盖层只在它变化时处理
+    s32 brightness;   // 0-100，或 DCLIGHT_BRIGHTNESS_NONE 表示使用 alpha
+    u32 alpha;        // 0-15，brightness 为 NONE 时生效
+    u32 ramp_ms;      // 过渡到目标值的时长，0 表示立即生效
+    u32 reserved[11];
+} __attribute__((aligned(64))) DClightMailboxControl;
+
+typedef struct {
+    u32 seq;
+    u32 generation;      // 覆盖层最近一次应用的 control.generation
+    s32 brightness;
+    u32 alpha;
+    u32 presented_alpha; // 或 DCLIGHT_ALPHA_NONE
+    u32 flags;           // DClightStatusFlag
+    u32 reserved[10];
+} __attribute__((aligned(64))) DClightMailboxStatus;
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 reserved[14];
+    DClightMailboxControl control;
+    DClightMailboxStatus status;
+} DClightMailbox;
+
+#if defined __cplusplus
+static_assert(sizeof(DClightMailbox) <= DCLIGHT_MAILBOX_SIZE, "mailbox must fit in one page");
+#else
+_Static_assert(sizeof(DClightMailbox) <= DCLIGHT_MAILBOX_SIZE, "mailbox must fit in one page");
+#endif
+
+// 对端可能在写入途中被终止，读者只重试有限次数，避免永远卡在奇数序号上
+#define DCLIGHT_SEQLOCK_MAX_RETRIES 64
+
+// 写者：更新 seq 之后的全部字段；序号先取偶数，可从对端写入中途退出的状态恢复
+static inline void dclightSeqlockStore(void *dst, const void *src, size_t size) {
+    u32 *seq = (u32 *)dst;
+    u32 start = __atomic_load_n(seq, __ATOMIC_RELAXED) & ~1u;
+
+    __atomic_store_n(seq, start + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy((u8 *)dst + sizeof(u32), (const u8 *)src + sizeof(u32), size - sizeof(u32));
+    __atomic_store_n(seq, start + 2, __ATOMIC_RELEASE);
+}
+
+// 读者：读到一份一致的快照返回 true；写者一直未完成时返回 false
+static inline bool dclightSeqlockLoad(void *dst, const void *src, size_t size) {
+    const u32 *seq = (const u32 *)src;
+
+    for (int i = 0; i < DCLIGHT_SEQLOCK_MAX_RETRIES; ++i) {
+        u32 start = __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+        if (start & 1) continue;
+
+        memcpy(dst, src, size);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(seq, __ATOMIC_RELAXED) == start) {
+            *(u32 *)dst = start;
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline void dclightMailboxControlStore(DClightMailbox *mb, const DClightMailboxControl *ctrl) {
+    dclightSeqlockStore(&mb->control, ctrl, sizeof(*ctrl));
+}
+
+static inline bool dclightMailboxControlLoad(const DClightMailbox *mb, DClightMailboxControl *out) {
+    return dclightSeqlockLoad(out, &mb->control, sizeof(*out));
+}
+
+static inline void dclightMailboxStatusStore(DClightMailbox *mb, const DClightMailboxStatus *st) {
+    dclightSeqlockStore(&mb->status, st, sizeof(*st));
+}
+
+static inline bool dclightMailboxStatusLoad(const DClightMailbox *mb, DClightMailboxStatus *out) {
+    return dclightSeqlockLoad(out, &mb->status, sizeof(*out));
+}
+
+// 无锁读取 control.generation，用于判断是否有新的提交
+static inline u32 dclightMailboxControlGeneration(const DClightMailbox *mb) {
+    return __atomic_load_n(&mb->control.generation, __ATOMIC_ACQUIRE);
+}
+
+#if defined __cplusplus
+}
+#endif
@@ -0,0 +1,113 @@
+/* DClight IPC 客户端实现 */
+#include <dclight/client/ipc.h>
+
+static Service g_dclightSrv;
+static u32 g_refCnt;
+
+bool dclightIpcRunning(void)
+{
+    // smGetService 会一直阻塞到服务注册为止，这里用注册同名服务的方式探测
+    Handle handle;
+    SmServiceName name = smEncodeName(DCLIGHT_IPC_SERVICE_NAME);
+    bool running = R_FAILED(smRegisterService(&handle, name, false, 1));
+
+    if (!running)
+    {
+        svcCloseHandle(handle);
+        smUnregisterService(name);
+    }
+
+    return running;
+}
+
+Result dclightIpcInitialize(void)
+{
+    g_refCnt++;
+
+    if (serviceIsActive(&g_dclightSrv))
+        return 0;
+
+    Result rc = smGetService(&g_dclightSrv, DCLIGHT_IPC_SERVICE_NAME);
+    if (R_FAILED(rc))
+        dclightIpcExit();
+
+    return rc;
+}
+
+void dclightIpcExit(void)
+{
+    if (g_refCnt && --g_refCnt == 0)
+        serviceClose(&g_dclightSrv);
+}
+
+bool dclightIpcIsActive(void)
+{
+    return serviceIsActive(&g_dclightSrv);
+}
+
+Result dclightIpcGetApiVersion(u32* out_ver)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetApiVersion, *out_ver);
+}
+
+Result dclightIpcGetBrightness(s32* out_brightness)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetBrightness, *out_brightness);
+}
+
+Result dclightIpcSetBrightness(u32 brightness)
+{
+    return serviceDispatchIn(&g_dclightSrv, DClightIpcCmd_SetBrightness, brightness);
+}
+
+Result dclightIpcGetAlpha(u32* out_alpha)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetAlpha, *out_alpha);
+}
+
+Result dclightIpcSetAlpha(u32 alpha)
+{
+    return serviceDispatchIn(&g_dclightSrv, DClightIpcCmd_SetAlpha, alpha);
+}
+
+Result dclightIpcGetStatus(DClightStatus* out_status)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetStatus, *out_status);
+}
+
+Result dclightIpcGetMailbox(Handle* out_shmem, Handle* out_doorbell)
+{
+    Handle handles[2];
+    Result rc = serviceDispatch(&g_dclightSrv, DClightIpcCmd_GetMailbox,
+        .out_handle_attrs = { SfOutHandleAttr_HipcCopy, SfOutHandleAttr_HipcCopy },
+        .out_handles = handles,
+    );
+
+    if (R_SUCCEEDED(rc))
+    {
+        *out_shmem = handles[0];
+        *out_doorbell = handles[1];
+    }
+
+    return rc;
+}
+
+Result dclightIpcReloadConfig(void)
+{
+    return serviceDispatch(&g_dclightSrv, DClightIpcCmd_ReloadConfig);
+}
+
+Result dclightIpcGetMemoryStats(DClightMemoryStats* out_stats)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetMemoryStats, *out_stats);
+}
+
+Result dclightIpcGetBootTrace(DClightBootTrace* out_trace)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetBootTrace, *out_trace);
+}
+
+Result dclightIpcGetMetrics(DClightMetrics* out_metrics)
+{
+    return serviceDispatchOut(&g_dclightSrv, DClightIpcCmd_GetMetrics, *out_metrics);
+}
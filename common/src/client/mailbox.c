@@ -0,0 +1,79 @@
+/* DClight 共享内存信箱客户端实现 */
+#include <dclight/client/ipc.h>
+#include <dclight/client/mailbox.h>
+
+static SharedMemory g_shmem;
+static Handle g_doorbell = INVALID_HANDLE;
+static DClightMailbox* g_mailbox = NULL;
+static u32 g_generation;
+
+Result dclightMailboxOpen(void)
+{
+    if (g_mailbox)
+        return 0;
+
+    Handle shmem, doorbell;
+    Result rc = dclightIpcGetMailbox(&shmem, &doorbell);
+    if (R_FAILED(rc))
+        return rc;
+
+    shmemLoadRemote(&g_shmem, shmem, DCLIGHT_MAILBOX_SIZE, Perm_Rw);
+    rc = shmemMap(&g_shmem);
+    if (R_FAILED(rc))
+    {
+        shmemClose(&g_shmem);
+        svcCloseHandle(doorbell);
+        return rc;
+    }
+
+    DClightMailbox* mailbox = (DClightMailbox*)shmemGetAddr(&g_shmem);
+    if (mailbox->magic != DCLIGHT_MAILBOX_MAGIC || mailbox->version != DCLIGHT_MAILBOX_VERSION)
+    {
+        shmemClose(&g_shmem);
+        svcCloseHandle(doorbell);
+        return DCLIGHT_ERROR(Generic);
+    }
+
+    g_mailbox = mailbox;
+    g_doorbell = doorbell;
+    // 本进程是 control 的唯一写者，从当前值继续递增
+    g_generation = dclightMailboxControlGeneration(mailbox);
+    return 0;
+}
+
+void dclightMailboxClose(void)
+{
+    if (!g_mailbox)
+        return;
+
+    shmemClose(&g_shmem);
+    svcCloseHandle(g_doorbell);
+    g_doorbell = INVALID_HANDLE;
+    g_mailbox = NULL;
+}
+
+bool dclightMailboxIsOpen(void)
+{
+    return g_mailbox != NULL;
+}
+
+Result dclightMailboxSubmit(s32 brightness, u32 alpha, u32 ramp_ms)
+{
+    if (!g_mailbox)
+        return MAKERESULT(Module_Libnx, LibnxError_NotInitialized);
+
+    DClightMailboxControl ctrl = {
+        .generation = ++g_generation,
+        .brightness = brightness,
+        .alpha = alpha,
+        .ramp_ms = ramp_ms,
+    };
+    dclightMailboxControlStore(g_mailbox, &ctrl);
+
+    return svcSignalEvent(g_doorbell);
+}
+
+bool dclightMailboxReadStatus(DClightMailboxStatus* out_status)
+{
+    return g_mailbox && dclightMailboxStatusLoad(g_mailbox, out_status);
+}
@@ -0,0 +1,441 @@
+/* 块线性填充/混合内核基准：对比逐像素 setPixel / setPixelBlendDst（libtesla getPixelOffset + 浮点 blendColor）
+ * 与 bl_fill / bl_fill_rect / bl_blend_rect
+ *
+ * 用法:
+ *   dclight-bench-fill [迭代时间ms]
+ * 对每个分辨率先校验内核（填充、混合、贴图）与逐像素路径写出的可见像素完全一致，再分别计时；
+ * 之后对 RGBA4444 / RGBA8888 / RGB565A 各自校验并报告整屏填充、混合、A8 贴图混合的耗时和每字节耗时
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gfx/blocklinear.h"
+#include "gfx/blend.h"
+#include "gfx/blit.h"
+
+typedef struct {
+    u32 width;
+    u32 height;
+} BenchSize;
+
+static const BenchSize g_sizes[] = {
+    { 1, 1 },
+    { 64, 36 },
+    { 1280, 720 },
+    { 1920, 1080 },
+};
+
+// 与 framebufferCreate 一致：stride 按 64 字节对齐，高度按块高对齐
+static BlSurface surface_create_format(u32 width, u32 height, BlFormat format, size_t *out_size) {
+    BlSurface s = { .width = width, .height = height, .format = format };
+    s.stride = (width * bl_format_bpp(format) + 63) & ~63u;
+    size_t size = (size_t)s.stride * ((height + BL_BLOCK_HEIGHT - 1) & ~(BL_BLOCK_HEIGHT - 1));
+    s.pixels = aligned_alloc(4096, (size + 4095) & ~(size_t)4095);
+    memset(s.pixels, 0, size);
+    *out_size = size;
+    return s;
+}
+
+static BlSurface surface_create(u32 width, u32 height, size_t *out_size) {
+    return surface_create_format(width, height, BlFormat_RGBA4444, out_size);
+}
+
+// 原实现：libtesla getPixelOffset + 带边界检查的 setPixel
+static u32 tesla_pixel_offset(u32 width, s32 x, s32 y) {
+    u32 tmpPos = ((y & 127) / 16) + (x / 32 * 8) + ((y / 16 / 8) * (((width / 2) / 16 * 8)));
+    tmpPos *= 16 * 16 * 4;
+    tmpPos += ((y % 16) / 8) * 512 + ((x % 32) / 16) * 256 + ((y % 8) / 2) * 64 + ((x % 16) / 8) * 32 + (y % 2) * 16 + (x % 8) * 2;
+    return tmpPos / 2;
+}
+
+static void naive_fill_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color) {
+    for (s32 yi = y; yi < y + h; ++yi) {
+        for (s32 xi = x; xi < x + w; ++xi) {
+            if (xi < 0 || yi < 0 || xi >= (s32)s->width || yi >= (s32)s->height) continue;
+            ((u16 *)s->pixels)[tesla_pixel_offset(s->width, xi, yi)] = (u16)color;
+        }
+    }
+}
+
+// 原实现：libtesla blendColor（浮点除以 15）
+static u8 tesla_blend_color(u8 src, u8 dst, u8 alpha) {
+    u8 oneMinusAlpha = 0x0F - alpha;
+    return (u8)((dst * alpha + src * oneMinusAlpha) / (float)0xF);
+}
+
+static void naive_blend_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color) {
+    u8 cr = color & 0xF, cg = (color >> 4) & 0xF, cb = (color >> 8) & 0xF, ca = color >> 12;
+    for (s32 xi = x; xi < x + w; ++xi) {
+        for (s32 yi = y; yi < y + h; ++yi) {
+            if (xi < 0 || yi < 0 || xi >= (s32)s->width || yi >= (s32)s->height) continue;
+            u16 *p = &((u16 *)s->pixels)[tesla_pixel_offset(s->width, xi, yi)];
+            u8 r = tesla_blend_color(*p & 0xF, cr, ca);
+            u8 g = tesla_blend_color((*p >> 4) & 0xF, cg, ca);
+            u8 b = tesla_blend_color((*p >> 8) & 0xF, cb, ca);
+            u16 a = (*p >> 12) + ca;
+            if (a > 0xF) a = 0xF;
+            *p = (u16)(r | (g << 4) | (b << 8) | (a << 12));
+        }
+    }
+}
+
+// 比较两个表面的可见像素
+static bool surfaces_match(const BlSurface *a, const BlSurface *b) {
+    for (u32 y = 0; y < a->height; ++y) {
+        for (u32 x = 0; x < a->width; ++x) {
+            u32 bpp = bl_format_bpp(a->format);
+            u32 i = bl_pixel_index(a, x, y) * bpp;
+            if (memcmp((u8 *)a->pixels + i, (u8 *)b->pixels + i, bpp) != 0) {
+                u32 pa = 0, pb = 0;
+                memcpy(&pa, (u8 *)a->pixels + i, bpp);
+                memcpy(&pb, (u8 *)b->pixels + i, bpp);
+                fprintf(stderr, "像素不一致 (%u,%u): %08x != %08x\n", x, y, pa, pb);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 逐像素贴图参考实现（语义见 gfx/blit.h）
+static void naive_blit(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img,
+                       s32 sx, s32 sy, s32 w, s32 h, u16 tint, u32 flags) {
+    for (s32 r = 0; r < h; ++r) {
+        for (s32 c = 0; c < w; ++c) {
+            s32 ix = sx + c, iy = sy + r, ox = dx + c, oy = dy + r;
+            if (ix < 0 || iy < 0 || ix >= (s32)img->width || iy >= (s32)img->height) continue;
+            if (ox < 0 || oy < 0 || ox >= (s32)s->width || oy >= (s32)s->height) continue;
+            const u8 *row = (const u8 *)img->pixels + iy * img->pitch;
+            u16 px;
+            if (img->format == BlitFormat_RGBA4444) {
+                memcpy(&px, row + ix * 2, 2);
+            } else {
+                u32 a = img->format == BlitFormat_A4
+                    ? ((row[ix / 2] >> ((ix & 1) * 4)) & 0xF) * (tint >> 12) / 15
+                    : (row[ix] * (tint >> 12) + 127) / 255;
+                px = (u16)((tint & 0x0FFF) | (a << 12));
+            }
+            u16 *p = &((u16 *)s->pixels)[tesla_pixel_offset(s->width, ox, oy)];
+            *p = (flags & BlitFlag_Blend) ? blend_pixel(*p, px) : px;
+        }
+    }
+}
+
+static bool verify_blit(BlSurface *ref, BlSurface *out) {
+    static u8 data[3][64 * 48 * 2];
+    for (size_t i = 0; i < sizeof(data[0]); ++i) {
+        data[0][i] = (u8)(i * 131 + 7);
+        data[1][i] = (u8)(i * 73 + 3);
+        data[2][i] = (u8)(i * 29 + 11);
+    }
+    const BlitImage images[] = {
+        { data[0], 61, 45, 61 * 2 + 6, BlitFormat_RGBA4444 },
+        { data[1], 47, 40, 24, BlitFormat_A4 },
+        { data[2], 53, 37, 53, BlitFormat_A8 },
+    };
+    const s32 blits[][6] = {
+        // dx, dy, sx, sy, w, h
+        { 0, 0, 0, 0, 64, 48 },
+        { 5, 3, 2, 1, 40, 30 },
+        { -7, -9, 0, 0, 64, 48 },
+        { (s32)ref->width - 20, (s32)ref->height - 10, 3, 4, 64, 48 },
+        { 30, 120, -5, -3, 33, 17 },
+    };
+
+    for (size_t i = 0; i < sizeof(images) / sizeof(images[0]); ++i) {
+        for (size_t j = 0; j < sizeof(blits) / sizeof(blits[0]); ++j) {
+            for (u32 flags = 0; flags <= BlitFlag_Blend; ++flags) {
+                u16 tint = (u16)(0x9ABC + j * 0x1357);
+                naive_blit(ref, blits[j][0], blits[j][1], &images[i], blits[j][2], blits[j][3], blits[j][4], blits[j][5], tint, flags);
+                bl_blit(out, blits[j][0], blits[j][1], &images[i], blits[j][2], blits[j][3], blits[j][4], blits[j][5], tint, flags);
+                if (!surfaces_match(ref, out)) {
+                    fprintf(stderr, "贴图不一致: format=%d blit=%zu flags=%u\n", images[i].format, j, flags);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+typedef void (*FillFn)(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color);
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// 成批重复执行（批大小翻倍，避免计时开销淹没 1x1 这样的小尺寸），直到超过 budget_ns，返回单次耗时（ns）
+static double bench(FillFn fn, const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color, double budget_ns) {
+    u64 iterations = 0;
+    u64 batch = 1;
+    double start = now_ns();
+    double elapsed;
+    do {
+        for (u64 i = 0; i < batch; ++i) {
+            fn(s, x, y, w, h, color);
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = now_ns() - start;
+    } while (elapsed < budget_ns);
+    return elapsed / iterations;
+}
+
+static bool verify(u32 width, u32 height) {
+    // 整屏、内部非对齐矩形、越界矩形
+    const s32 rects[][4] = {
+        { 0, 0, (s32)width, (s32)height },
+        { 3, 5, (s32)width / 2 + 7, (s32)height / 2 + 9 },
+        { (s32)width / 3 + 1, (s32)height / 4 + 3, (s32)width, (s32)height },
+        { -10, -20, 45, 150 },
+        { 31, 7, 2, 130 },
+    };
+
+    size_t size;
+    BlSurface ref = surface_create(width, height, &size);
+    BlSurface out = surface_create(width, height, &size);
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(rects) / sizeof(rects[0]) && ok; ++i) {
+        u16 color = (u16)(0x1234 + i * 0x1111);
+        naive_fill_rect(&ref, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        bl_fill_rect(&out, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        ok = surfaces_match(&ref, &out);
+    }
+    // 在已有内容上叠加半透明颜色
+    for (size_t i = 0; i < sizeof(rects) / sizeof(rects[0]) && ok; ++i) {
+        u16 color = (u16)(0x3A5C + i * 0x2137);
+        naive_blend_rect(&ref, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        bl_blend_rect(&out, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        ok = surfaces_match(&ref, &out);
+    }
+    if (ok) ok = verify_blit(&ref, &out);
+    free(ref.pixels);
+    free(out.pixels);
+    return ok;
+}
+
+/* ---- 各像素格式：参考实现按定义逐像素计算（除以 255 用真正的除法） ---- */
+
+static const char *const g_formatNames[BlFormat_Count] = { "RGBA4444", "RGBA8888", "RGB565A" };
+
+// 32bpp 像素看成两个相邻的 16bpp 像素，沿用 libtesla 的布局
+static u32 ref_byte_offset(const BlSurface *s, s32 x, s32 y) {
+    u32 halves = bl_format_bpp(s->format) / 2;
+    return tesla_pixel_offset(s->width * halves, x * (s32)halves, y) * 2;
+}
+
+static u32 ref_get(const BlSurface *s, s32 x, s32 y) {
+    u32 px = 0;
+    memcpy(&px, (u8 *)s->pixels + ref_byte_offset(s, x, y), bl_format_bpp(s->format));
+    return px;
+}
+
+static void ref_put(const BlSurface *s, s32 x, s32 y, u32 px) {
+    memcpy((u8 *)s->pixels + ref_byte_offset(s, x, y), &px, bl_format_bpp(s->format));
+}
+
+static u32 ref_mix255(u32 src, u32 dst, u32 a) {
+    return (src * a + dst * (255 - a)) / 255;
+}
+
+static u32 ref_blend(BlFormat format, u32 dst, u32 color) {
+    switch (format) {
+        case BlFormat_RGBA8888: {
+            u32 a = color >> 24, out = 0;
+            for (u32 c = 0; c < 24; c += 8) out |= ref_mix255((color >> c) & 0xFF, (dst >> c) & 0xFF, a) << c;
+            u32 outA = (dst >> 24) + a;
+            return out | ((outA > 255 ? 255 : outA) << 24);
+        }
+        case BlFormat_RGB565A: {
+            u32 a = (color >> 16) & 0xFF;
+            return ref_mix255(color & 0x1F, dst & 0x1F, a)
+                 | ref_mix255((color >> 5) & 0x3F, (dst >> 5) & 0x3F, a) << 5
+                 | ref_mix255((color >> 11) & 0x1F, (dst >> 11) & 0x1F, a) << 11;
+        }
+        default: {
+            u8 ca = (color >> 12) & 0xF;
+            u32 a = (dst >> 12) + ca;
+            return tesla_blend_color(dst & 0xF, color & 0xF, ca)
+                 | tesla_blend_color((dst >> 4) & 0xF, (color >> 4) & 0xF, ca) << 4
+                 | tesla_blend_color((dst >> 8) & 0xF, (color >> 8) & 0xF, ca) << 8
+                 | (a > 0xF ? 0xF : a) << 12;
+        }
+    }
+}
+
+static void ref_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color, bool blend) {
+    for (s32 yi = y; yi < y + h; ++yi) {
+        for (s32 xi = x; xi < x + w; ++xi) {
+            if (xi < 0 || yi < 0 || xi >= (s32)s->width || yi >= (s32)s->height) continue;
+            ref_put(s, xi, yi, blend ? ref_blend(s->format, ref_get(s, xi, yi), color) : color);
+        }
+    }
+}
+
+// 源像素 -> 目标格式（语义见 gfx/blit.h）
+static u32 ref_fetch(BlFormat format, const BlitImage *img, s32 ix, s32 iy, u32 tint) {
+    const u8 *row = (const u8 *)img->pixels + iy * img->pitch;
+    if (img->format == BlitFormat_RGBA4444) {
+        u16 px;
+        memcpy(&px, row + ix * 2, 2);
+        if (format == BlFormat_RGBA4444) return px;
+        return bl_format_pack(format, (px & 0xF) * 17, ((px >> 4) & 0xF) * 17, ((px >> 8) & 0xF) * 17, (px >> 12) * 17);
+    }
+    u32 a8 = img->format == BlitFormat_A4 ? ((row[ix / 2] >> ((ix & 1) * 4)) & 0xF) * 17 : row[ix];
+    switch (format) {
+        case BlFormat_RGBA8888: return (tint & 0xFFFFFF) | ((a8 * (tint >> 24) + 127) / 255) << 24;
+        case BlFormat_RGB565A:  return (tint & 0xFFFF) | ((a8 * ((tint >> 16) & 0xFF) + 127) / 255) << 16;
+        default: {
+            u32 tA = (tint >> 12) & 0xF;
+            u32 a = img->format == BlitFormat_A4 ? (a8 / 17) * tA / 15 : (a8 * tA + 127) / 255;
+            return (tint & 0x0FFF) | (a << 12);
+        }
+    }
+}
+
+static void ref_blit(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img,
+                     s32 sx, s32 sy, s32 w, s32 h, u32 tint, u32 flags) {
+    for (s32 r = 0; r < h; ++r) {
+        for (s32 c = 0; c < w; ++c) {
+            s32 ix = sx + c, iy = sy + r, ox = dx + c, oy = dy + r;
+            if (ix < 0 || iy < 0 || ix >= (s32)img->width || iy >= (s32)img->height) continue;
+            if (ox < 0 || oy < 0 || ox >= (s32)s->width || oy >= (s32)s->height) continue;
+            u32 px = ref_fetch(s->format, img, ix, iy, tint);
+            if (flags & BlitFlag_Blend) px = ref_blend(s->format, ref_get(s, ox, oy), px);
+            else if (s->format == BlFormat_RGB565A) px &= 0xFFFF;
+            ref_put(s, ox, oy, px);
+        }
+    }
+}
+
+static bool verify_format(BlFormat format, u32 width, u32 height) {
+    const s32 rects[][4] = {
+        { 0, 0, (s32)width, (s32)height },
+        { 3, 5, (s32)width / 2 + 7, (s32)height / 2 + 9 },
+        { (s32)width / 3 + 1, (s32)height / 4 + 3, (s32)width, (s32)height },
+        { -10, -20, 45, 150 },
+        { 13, 7, 2, 130 },
+    };
+    static u8 data[3][64 * 48 * 2];
+    for (size_t i = 0; i < sizeof(data[0]); ++i) {
+        data[0][i] = (u8)(i * 131 + 7);
+        data[1][i] = (u8)(i * 73 + 3);
+        data[2][i] = (u8)(i * 29 + 11);
+    }
+    const BlitImage images[] = {
+        { data[0], 61, 45, 61 * 2 + 6, BlitFormat_RGBA4444 },
+        { data[1], 47, 40, 24, BlitFormat_A4 },
+        { data[2], 53, 37, 53, BlitFormat_A8 },
+    };
+
+    size_t size;
+    BlSurface ref = surface_create_format(width, height, format, &size);
+    BlSurface out = surface_create_format(width, height, format, &size);
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(rects) / sizeof(rects[0]) && ok; ++i) {
+        u32 color = bl_format_pack(format, (u8)(i * 53 + 17), (u8)(i * 91 + 40), (u8)(i * 37 + 200), 0xFF);
+        ref_rect(&ref, rects[i][0], rects[i][1], rects[i][2], rects[i][3], format == BlFormat_RGB565A ? color & 0xFFFF : color, false);
+        bl_fill_rect(&out, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        ok = surfaces_match(&ref, &out);
+    }
+    for (size_t i = 0; i < sizeof(rects) / sizeof(rects[0]) && ok; ++i) {
+        u32 color = bl_format_pack(format, (u8)(i * 71 + 9), (u8)(i * 13 + 120), (u8)(i * 97 + 3), (u8)(i * 61 + 30));
+        ref_rect(&ref, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color, true);
+        bl_blend_rect(&out, rects[i][0], rects[i][1], rects[i][2], rects[i][3], color);
+        ok = surfaces_match(&ref, &out);
+    }
+    for (size_t i = 0; i < sizeof(images) / sizeof(images[0]) && ok; ++i) {
+        for (u32 flags = 0; flags <= BlitFlag_Blend && ok; ++flags) {
+            u32 tint = bl_format_pack(format, 0x9A, 0xBC, 0x35, (u8)(0x47 + i * 0x51));
+            s32 dx = (s32)(i * 5) - 3, dy = (s32)(i * 7) + 1;
+            ref_blit(&ref, dx, dy, &images[i], 2, 1, 60, 44, tint, flags);
+            bl_blit(&out, dx, dy, &images[i], 2, 1, 60, 44, tint, flags);
+            ok = surfaces_match(&ref, &out);
+            if (!ok) fprintf(stderr, "贴图不一致: format=%d flags=%u\n", images[i].format, flags);
+        }
+    }
+    free(ref.pixels);
+    free(out.pixels);
+    return ok;
+}
+
+// 整屏 A8 图像带 tint 混合贴图，签名与 FillFn 一致以便复用 bench()
+static BlitImage g_benchImage;
+
+static void blit_a8_blend(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 tint) {
+    bl_blit(s, x, y, &g_benchImage, 0, 0, w, h, tint, BlitFlag_Blend);
+}
+
+// 对每个格式：校验，再对整屏填充 / 半透明黑色混合 / A8 贴图混合计时
+static bool bench_formats(double budget_ns) {
+    for (u32 n = 0; n <= 255 * 255; ++n) {
+        if (blend_div255(n) != n / 255) {
+            fprintf(stderr, "blend_div255(%u) != %u\n", n, n / 255);
+            return false;
+        }
+    }
+
+    printf("\n%-10s %-10s %12s %12s %12s %12s %12s\n", "format", "size", "fill ns", "fill B/ns", "blend ns", "blend B/ns", "blit ns");
+    for (u32 f = 0; f < BlFormat_Count; ++f) {
+        BlFormat format = (BlFormat)f;
+        for (size_t i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]); ++i) {
+            u32 w = g_sizes[i].width, h = g_sizes[i].height;
+            if (!verify_format(format, w, h)) {
+                fprintf(stderr, "%s %ux%u: 校验失败\n", g_formatNames[f], w, h);
+                return false;
+            }
+            if (w * h < 1280 * 720) continue;
+
+            size_t size;
+            BlSurface s = surface_create_format(w, h, format, &size);
+            double fill = bench(bl_fill_rect, &s, 0, 0, (s32)w, (s32)h, bl_format_pack(format, 0, 0, 0, 0xFF), budget_ns);
+            double blend = bench(bl_blend_rect, &s, 0, 0, (s32)w, (s32)h, bl_format_pack(format, 0, 0, 0, 0x80), budget_ns);
+            u8 *alpha = malloc((size_t)w * h);
+            for (size_t k = 0; k < (size_t)w * h; ++k) alpha[k] = (u8)(k * 29 + 11);
+            g_benchImage = (BlitImage){ alpha, w, h, w, BlitFormat_A8 };
+            double blit = bench(blit_a8_blend, &s, 0, 0, (s32)w, (s32)h, bl_format_pack(format, 0x9A, 0xBC, 0x35, 0xC0), budget_ns);
+            free(alpha);
+            free(s.pixels);
+
+            char label[16];
+            snprintf(label, sizeof(label), "%ux%u", w, h);
+            printf("%-10s %-10s %12.1f %12.2f %12.1f %12.2f %12.1f\n", g_formatNames[f], label, fill, size / fill, blend, size / blend, blit);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    double budget_ns = (argc > 1 ? atof(argv[1]) : 200.0) * 1e6;
+
+    printf("%-10s %14s %14s %14s %9s %14s %14s %9s\n", "size", "setPixel ns", "bl_fill ns", "rect ns", "speedup",
+           "blendDst ns", "bl_blend ns", "speedup");
+    for (size_t i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]); ++i) {
+        u32 w = g_sizes[i].width, h = g_sizes[i].height;
+        if (!verify(w, h)) {
+            fprintf(stderr, "%ux%u: 校验失败\n", w, h);
+            return 1;
+        }
+
+        size_t size;
+        BlSurface s = surface_create(w, h, &size);
+        double naive = bench(naive_fill_rect, &s, 0, 0, (s32)w, (s32)h, 0xF123, budget_ns);
+        double fill = bench(bl_fill_rect, &s, 0, 0, (s32)w, (s32)h, 0xF123, budget_ns);
+        // 不对齐的内部矩形，测边缘路径
+        double rect = bench(bl_fill_rect, &s, 3, 5, (s32)w - 6 > 0 ? (s32)w - 6 : 1, (s32)h - 10 > 0 ? (s32)h - 10 : 1, 0xF123, budget_ns);
+        // 半透明黑色整屏暗化
+        double naiveBlend = bench(naive_blend_rect, &s, 0, 0, (s32)w, (s32)h, 0x8000, budget_ns);
+        double blend = bench(bl_blend_rect, &s, 0, 0, (s32)w, (s32)h, 0x8000, budget_ns);
+        free(s.pixels);
+
+        char label[16];
+        snprintf(label, sizeof(label), "%ux%u", w, h);
+        printf("%-10s %14.1f %14.1f %14.1f %8.1fx %14.1f %14.1f %8.1fx\n", label, naive, fill, rect, naive / fill,
+               naiveBlend, blend, naiveBlend / blend);
+    }
+    return bench_formats(budget_ns) ? 0 : 1;
+}
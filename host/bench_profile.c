@@ -0,0 +1,139 @@
+/* 按应用配置表基准：构建含 N 个应用的表，校验查找结果后计时命中与未命中的查找
+ *
+ * 用法:
+ *   dclight-bench-profile [迭代时间ms]
+ * title ID 按真实分布生成（0100 前缀、低 12 位为 0），这正是直接取低位做哈希时最坏的情况
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "profile.h"
+
+static const u32 g_counts[] = { 1, 16, 300, 2000 };
+
+static u64 g_rng = 0x2545F4914F6CDD1DULL;
+
+static u64 next_random(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return g_rng;
+}
+
+// 0100xxxxxxxxx000 形式的应用 ID
+static u64 random_title_id(void) {
+    return 0x0100000000000000ULL | ((next_random() & 0xFFFFFFFFFULL) << 12);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// 成批重复查找 ids 中的每一项，直到超过 budget_ns，返回单次查找耗时（ns）
+static double bench(const ProfileTable *table, const u64 *ids, u32 count, double budget_ns, u32 *out_hits) {
+    u64 lookups = 0;
+    u64 batch = 1;
+    u32 hits = 0;
+    double start = now_ns();
+    double elapsed;
+    do {
+        for (u64 b = 0; b < batch; ++b) {
+            for (u32 i = 0; i < count; ++i) {
+                hits += profile_lookup(table, ids[i]) != NULL;
+            }
+        }
+        lookups += batch * count;
+        batch *= 2;
+        elapsed = now_ns() - start;
+    } while (elapsed < budget_ns);
+    *out_hits = hits;
+    return elapsed / (double)lookups;
+}
+
+static bool check_sections(void) {
+    static const struct {
+        const char *section;
+        bool ok;
+        u64 id;
+    } cases[] = {
+        { "title_0100000000001000", true, TITLE_ID_HOME_MENU },
+        { "TITLE_0x01007EF00011E000", true, 0x01007EF00011E000ULL },
+        { "title_", false, 0 },
+        { "title_0", false, 0 },
+        { "title_01000000000010000", false, 0 },
+        { "title_0100zz", false, 0 },
+        { "overlay", false, 0 },
+    };
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        u64 id = 0;
+        bool parsed = profile_parse_section(cases[i].section, &id);
+        if (parsed != cases[i].ok || (parsed && id != cases[i].id)) {
+            fprintf(stderr, "节名解析错误: %s\n", cases[i].section);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    double budget_ns = (argc > 1 ? atof(argv[1]) : 200.0) * 1e6;
+
+    if (!check_sections()) return 1;
+
+    printf("%8s %8s %8s %14s %14s\n", "应用数", "槽数", "最长探测", "命中 ns/次", "未命中 ns/次");
+    for (size_t c = 0; c < sizeof(g_counts) / sizeof(g_counts[0]); ++c) {
+        u32 count = g_counts[c];
+        u64 *ids = malloc(count * sizeof(u64));
+        u64 *misses = malloc(count * sizeof(u64));
+
+        ProfileTable table;
+        profile_table_init(&table);
+        for (u32 i = 0; i < count; ++i) {
+            ids[i] = random_title_id();
+            TitleProfile *p = profile_table_upsert(&table, ids[i]);
+            p->brightness = (s16)(i % 101);
+        }
+        for (u32 i = 0; i < count; ++i) {
+            do {
+                misses[i] = random_title_id();
+            } while (profile_lookup(&table, misses[i]) != NULL);
+        }
+
+        // 校验：每个 ID 都能找到自己的配置，重复插入不增加项数
+        for (u32 i = 0; i < count; ++i) {
+            const TitleProfile *p = profile_lookup(&table, ids[i]);
+            if (p == NULL || p->title_id != ids[i] || profile_table_upsert(&table, ids[i]) != p) {
+                fprintf(stderr, "查找错误: %016llx\n", (unsigned long long)ids[i]);
+                return 1;
+            }
+        }
+
+        // 线性探测的最长探测长度
+        u32 longest = 0;
+        for (u32 i = 0; i <= table.mask; ++i) {
+            if (table.slots[i].title_id == 0) continue;
+            u32 home = (u32)((table.slots[i].title_id * 0x9E3779B97F4A7C15ULL) >> 32) & table.mask;
+            u32 probe = (i - home) & table.mask;
+            if (probe + 1 > longest) longest = probe + 1;
+        }
+
+        u32 hits, missHits;
+        double hit_ns = bench(&table, ids, count, budget_ns, &hits);
+        double miss_ns = bench(&table, misses, count, budget_ns, &missHits);
+        if (missHits != 0) {
+            fprintf(stderr, "未命中的查找返回了配置\n");
+            return 1;
+        }
+        printf("%8u %8u %8u %14.2f %14.2f\n", table.count, table.mask + 1, longest, hit_ns, miss_ns);
+
+        profile_table_free(&table);
+        free(ids);
+        free(misses);
+    }
+    return 0;
+}
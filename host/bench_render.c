@@ -0,0 +1,321 @@
+/* 渲染路径基准与金样校验：source/gfx 的绘制接口跑在内存帧缓冲上
+ *
+ * 用法:
+ *   dclight-bench-render [--dump out.ppm] [--dump-mask mask.ppm] [每项计时ms]
+ * 先在非 32 对齐宽度的帧缓冲上绘制一个测试场景，反 swizzle 后与线性参考实现逐像素比较（可导出 PPM），
+ * 再校验各形状的暗化掩码（可导出 PPM），
+ * 最后对各分辨率报告 fill / blend / swizzle / setPixel 的 ns/px 与 frames/s
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "render_harness.h"
+#include "gfx/mask.h"
+
+typedef struct {
+    u32 width;
+    u32 height;
+} BenchSize;
+
+static const BenchSize g_sizes[] = {
+    { 1, 1 },
+    { 64, 36 },
+    { 1280, 720 },
+    { 1920, 1080 },
+};
+
+/* ---- 线性参考实现（libtesla 的浮点 blendColor，按行存储） ---- */
+
+static u8 ref_blend_color(u8 src, u8 dst, u8 alpha) {
+    u8 oneMinusAlpha = 0x0F - alpha;
+    return (u8)((dst * alpha + src * oneMinusAlpha) / (float)0xF);
+}
+
+static u16 ref_blend(u16 dst, u16 color) {
+    u8 a = color >> 12;
+    u16 outA = (dst >> 12) + a;
+    if (outA > 0xF) outA = 0xF;
+    return (u16)(ref_blend_color(dst & 0xF, color & 0xF, a)
+        | (ref_blend_color((dst >> 4) & 0xF, (color >> 4) & 0xF, a) << 4)
+        | (ref_blend_color((dst >> 8) & 0xF, (color >> 8) & 0xF, a) << 8)
+        | (outA << 12));
+}
+
+typedef struct {
+    u16 *pixels;
+    u32 width;
+    u32 height;
+} RefImage;
+
+static u16 *ref_at(RefImage *img, s32 x, s32 y) {
+    if (x < 0 || y < 0 || x >= (s32)img->width || y >= (s32)img->height) return NULL;
+    return &img->pixels[(size_t)y * img->width + x];
+}
+
+static void ref_rect(RefImage *img, s32 x, s32 y, s32 w, s32 h, u16 color, bool blend) {
+    for (s32 yi = y; yi < y + h; ++yi) {
+        for (s32 xi = x; xi < x + w; ++xi) {
+            u16 *p = ref_at(img, xi, yi);
+            if (p) *p = blend ? ref_blend(*p, color) : color;
+        }
+    }
+}
+
+static void ref_image(RefImage *img, s32 dx, s32 dy, const BlitImage *src, u16 tint, bool blend) {
+    for (u32 r = 0; r < src->height; ++r) {
+        const u8 *row = (const u8 *)src->pixels + (size_t)r * src->pitch;
+        for (u32 c = 0; c < src->width; ++c) {
+            u16 *p = ref_at(img, dx + (s32)c, dy + (s32)r);
+            if (p == NULL) continue;
+            u16 px;
+            if (src->format == BlitFormat_RGBA4444) {
+                memcpy(&px, row + c * 2, sizeof(px));
+            } else {
+                u32 a = (row[c] * (tint >> 12) + 127) / 255; // 场景只用 A8
+                px = (u16)((tint & 0x0FFF) | (a << 12));
+            }
+            *p = blend ? ref_blend(*p, px) : px;
+        }
+    }
+}
+
+/* ---- 测试场景 ---- */
+
+#define GOLDEN_WIDTH  200 // stride 有填充
+#define GOLDEN_HEIGHT 150 // 跨两个块行
+
+static u8 g_glyph[40][64];        // A8 渐变
+static u16 g_icon[21][33 + 3];    // RGBA4444，pitch 大于宽度
+
+static void scene_init(void) {
+    for (u32 y = 0; y < 40; ++y)
+        for (u32 x = 0; x < 64; ++x)
+            g_glyph[y][x] = (u8)((x * 4 + y * 3) & 0xFF);
+    for (u32 y = 0; y < 21; ++y)
+        for (u32 x = 0; x < 36; ++x)
+            g_icon[y][x] = (u16)(((x * 5 + y * 7) & 0xFFF) | (((x + y) & 0xF) << 12));
+}
+
+static const BlitImage g_glyphImage = { g_glyph, 64, 40, 64, BlitFormat_A8 };
+static const BlitImage g_iconImage = { g_icon, 33, 21, sizeof(g_icon[0]), BlitFormat_RGBA4444 };
+
+static void scene_draw(void) {
+    startFrame();
+    fillScreenSolid((Color){ 1, 2, 3, 15 });
+    drawRect(10, 12, 150, 90, (Color){ 15, 0, 0, 8 });
+    drawRect(-20, 100, 80, 80, (Color){ 0, 15, 0, 4 });
+    drawImage(120, 70, &g_glyphImage, (Color){ 15, 15, 15, 12 }, true);
+    drawImage(5, 140, &g_iconImage, (Color){ 0, 0, 0, 0 }, false);
+    for (s32 i = 0; i < 150; ++i) {
+        setPixel(i + 30, i, (Color){ 15, 15, 0, 15 });
+        setPixelBlendDst(i + 32, i, (Color){ 0, 0, 15, 6 });
+    }
+    endFrame(false);
+}
+
+static void scene_reference(RefImage *img) {
+    ref_rect(img, 0, 0, (s32)img->width, (s32)img->height, color_to_u16((Color){ 1, 2, 3, 15 }), false);
+    ref_rect(img, 10, 12, 150, 90, color_to_u16((Color){ 15, 0, 0, 8 }), true);
+    ref_rect(img, -20, 100, 80, 80, color_to_u16((Color){ 0, 15, 0, 4 }), true);
+    ref_image(img, 120, 70, &g_glyphImage, color_to_u16((Color){ 15, 15, 15, 12 }), true);
+    ref_image(img, 5, 140, &g_iconImage, 0, false);
+    for (s32 i = 0; i < 150; ++i) {
+        u16 *p = ref_at(img, i + 30, i);
+        if (p) *p = color_to_u16((Color){ 15, 15, 0, 15 });
+        p = ref_at(img, i + 32, i);
+        if (p) *p = ref_blend(*p, color_to_u16((Color){ 0, 0, 15, 6 }));
+    }
+}
+
+static bool golden_check(const char *dump_path) {
+    MemFramebuffer mem;
+    if (!mem_framebuffer_create(&mem, GOLDEN_WIDTH, GOLDEN_HEIGHT)) return false;
+    renderBind(&mem.fb);
+    scene_init();
+    scene_draw();
+    renderBind(NULL);
+
+    static u16 actual[GOLDEN_WIDTH * GOLDEN_HEIGHT];
+    static u16 expected[GOLDEN_WIDTH * GOLDEN_HEIGHT];
+    mem_framebuffer_deswizzle(&mem, actual);
+    RefImage ref = { expected, GOLDEN_WIDTH, GOLDEN_HEIGHT };
+    scene_reference(&ref);
+    mem_framebuffer_destroy(&mem);
+
+    if (dump_path && !write_ppm(dump_path, actual, GOLDEN_WIDTH, GOLDEN_HEIGHT)) {
+        fprintf(stderr, "写入 %s 失败\n", dump_path);
+    }
+
+    u32 mismatches = 0;
+    for (u32 i = 0; i < GOLDEN_WIDTH * GOLDEN_HEIGHT; ++i) {
+        if (actual[i] == expected[i]) continue;
+        if (mismatches++ < 8) {
+            fprintf(stderr, "(%u,%u): %04x != %04x\n", i % GOLDEN_WIDTH, i / GOLDEN_WIDTH, actual[i], expected[i]);
+        }
+    }
+    printf("golden %ux%u: %s (%u mismatches)\n", GOLDEN_WIDTH, GOLDEN_HEIGHT, mismatches ? "FAIL" : "ok", mismatches);
+    return mismatches == 0;
+}
+
+/* ---- 暗化掩码 ---- */
+
+// 每种形状在默认分辨率下画出的像素必须等于 clamp(基准 + 增量)，且形状的方向正确
+static bool mask_check(const char *dump_path) {
+    static const char *const names[DimMask_Count] = { "none+light", "vignette", "top", "bottom", "topbottom" };
+    const u8 base = 5;
+    bool ok = true;
+    for (int shape = 0; shape < DimMask_Count; ++shape) {
+        DimMaskConfig cfg = {
+            .shape = (DimMaskShape)shape,
+            .width = DIM_MASK_DEFAULT_WIDTH, .height = DIM_MASK_DEFAULT_HEIGHT,
+            .strength = 8, .extent = 30,
+            .light_x = 70, .light_y = 5, .light_w = 25, .light_h = 20, .light_alpha = 4,
+        };
+        DimMask mask;
+        MemFramebuffer mem;
+        if (!dim_mask_build(&mask, &cfg) || !mem_framebuffer_create(&mem, cfg.width, cfg.height)) return false;
+        renderBind(&mem.fb);
+        startFrame();
+        dim_mask_draw(&mask, base);
+        endFrame(false);
+        renderBind(NULL);
+
+        u32 w = cfg.width, h = cfg.height;
+        u16 *actual = malloc((size_t)w * h * sizeof(u16));
+        mem_framebuffer_deswizzle(&mem, actual);
+
+        u32 mismatches = 0;
+        for (u32 i = 0; i < w * h; ++i) {
+            s32 a = base + mask.delta[i];
+            u16 expect = (u16)((a < 0 ? 0 : (a > 15 ? 15 : a)) << 12);
+            if (actual[i] != expect) mismatches++;
+        }
+
+        // 中心不受形状影响；形状所在的边缘比中心更暗
+        s32 center = mask.delta[(h / 2) * w + w / 2];
+        s32 top = mask.delta[w / 2], bottom = mask.delta[(h - 1) * w + w / 2], left = mask.delta[(h / 2) * w];
+        bool shaped = center == 0;
+        switch (shape) {
+            case DimMask_Vignette:  shaped = shaped && left > 0 && top > 0 && bottom > 0; break;
+            case DimMask_Top:       shaped = shaped && top > 0 && bottom == 0; break;
+            case DimMask_Bottom:    shaped = shaped && bottom > 0 && top == 0; break;
+            case DimMask_TopBottom: shaped = shaped && top > 0 && bottom > 0; break;
+            default:                shaped = shaped && mask.delta[5 * w + w * 8 / 10] == -4; break;
+        }
+
+        printf("mask %-10s %ux%u: %s (%u mismatches)\n", names[shape], w, h, mismatches || !shaped ? "FAIL" : "ok", mismatches);
+        ok = ok && mismatches == 0 && shaped;
+
+        if (dump_path && shape == DimMask_TopBottom && !write_ppm(dump_path, actual, w, h)) {
+            fprintf(stderr, "写入 %s 失败\n", dump_path);
+        }
+        free(actual);
+        mem_framebuffer_destroy(&mem);
+        dim_mask_free(&mask);
+    }
+    return ok;
+}
+
+/* ---- 计时 ---- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef void (*FrameFn)(u32 width, u32 height);
+
+static const BlitImage *g_screenImage; // swizzle 测试用的整屏线性图像
+
+static void frame_fill(u32 width, u32 height) {
+    (void)width; (void)height;
+    startFrame();
+    fillScreenSolid((Color){ 0, 0, 0, 9 });
+    endFrame(true);
+}
+
+static void frame_blend(u32 width, u32 height) {
+    (void)width; (void)height;
+    startFrame();
+    fillScreen((Color){ 0, 0, 0, 6 });
+    endFrame(true);
+}
+
+static void frame_swizzle(u32 width, u32 height) {
+    (void)width; (void)height;
+    startFrame();
+    drawImage(0, 0, g_screenImage, (Color){ 0, 0, 0, 0 }, false);
+    endFrame(true);
+}
+
+static void frame_setpixel(u32 width, u32 height) {
+    startFrame();
+    for (u32 y = 0; y < height; ++y)
+        for (u32 x = 0; x < width; ++x)
+            setPixel((s32)x, (s32)y, (Color){ 0, 0, 0, 9 });
+    endFrame(true);
+}
+
+// 成批重复直到超过 budget_ns，返回每帧耗时（ns）
+static double bench(FrameFn fn, u32 width, u32 height, double budget_ns) {
+    u64 frames = 0, batch = 1;
+    double start = now_ns(), elapsed;
+    do {
+        for (u64 i = 0; i < batch; ++i) fn(width, height);
+        frames += batch;
+        batch *= 2;
+        elapsed = now_ns() - start;
+    } while (elapsed < budget_ns);
+    return elapsed / frames;
+}
+
+int main(int argc, char **argv) {
+    const char *dump_path = NULL;
+    const char *mask_dump_path = NULL;
+    double budget_ns = 200e6;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) dump_path = argv[++i];
+        else if (strcmp(argv[i], "--dump-mask") == 0 && i + 1 < argc) mask_dump_path = argv[++i];
+        else budget_ns = atof(argv[i]) * 1e6;
+    }
+
+    if (!golden_check(dump_path)) return 1;
+    if (!mask_check(mask_dump_path)) return 1;
+
+    static const struct {
+        const char *name;
+        FrameFn fn;
+    } ops[] = {
+        { "fill",     frame_fill },
+        { "blend",    frame_blend },
+        { "swizzle",  frame_swizzle },
+        { "setPixel", frame_setpixel },
+    };
+
+    printf("%-10s %-9s %14s %10s %12s\n", "size", "op", "ns/frame", "ns/px", "frames/s");
+    for (size_t i = 0; i < sizeof(g_sizes) / sizeof(g_sizes[0]); ++i) {
+        u32 w = g_sizes[i].width, h = g_sizes[i].height;
+        MemFramebuffer mem;
+        if (!mem_framebuffer_create(&mem, w, h)) return 1;
+        u16 *linear = calloc((size_t)w * h, sizeof(u16));
+        for (size_t p = 0; p < (size_t)w * h; ++p) linear[p] = (u16)(p * 2654435761u >> 16);
+        BlitImage screen = { linear, w, h, w * 2, BlitFormat_RGBA4444 };
+        g_screenImage = &screen;
+        renderBind(&mem.fb);
+
+        char label[16];
+        snprintf(label, sizeof(label), "%ux%u", w, h);
+        for (size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); ++o) {
+            double ns = bench(ops[o].fn, w, h, budget_ns);
+            printf("%-10s %-9s %14.1f %10.3f %12.1f\n", label, ops[o].name, ns, ns / ((double)w * h), 1e9 / ns);
+        }
+
+        renderBind(NULL);
+        free(linear);
+        mem_framebuffer_destroy(&mem);
+    }
+    return 0;
+}
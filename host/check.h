@@ -0,0 +1,14 @@
+/* 宿主工具共用的检查：不满足时打印错误并记为失败，工具结束时按 g_ok 决定退出码 */
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+
+static bool g_ok = true;
+
+static inline void expect(bool cond, const char *what) {
+    if (!cond) {
+        fprintf(stderr, "错误: %s\n", what);
+        g_ok = false;
+    }
+}
@@ -0,0 +1,82 @@
+/* 快捷键模拟：按给定的采样间隔把一段按键脚本交给 hotkey_update，打印每次调节，并检查：
+ *   - 修饰键未全部按住时方向键不起作用
+ *   - 按下时立即调节一次，按住超过重复延迟后按固定间隔重复，错过的间隔不补发
+ *   - 上下同时按住不调节
+ *
+ * 用法:
+ *   dclight-hotkey [组合键]   例如 dclight-hotkey ZL+ZR（默认）
+ */
+#include <stdio.h>
+
+#include "check.h"
+#include "hotkey.h"
+
+#define MS 1000000ULL
+
+typedef struct {
+    u64 at_ms;     // 从这一刻起
+    u64 buttons;   // 按住的键（修饰键以外的部分）
+    bool modifier; // 是否按住修饰键
+    const char *what;
+} HotkeyStep;
+
+// 以 sample_ms 为间隔采样 [from_ms, to_ms)，返回累计的亮度变化量和调节次数
+static s32 run(HotkeyState *state, const HotkeyConfig *cfg, u64 buttons, u64 from_ms, u64 to_ms,
+               u64 sample_ms, u32 *steps) {
+    s32 total = 0;
+    *steps = 0;
+    for (u64 t = from_ms; t < to_ms; t += sample_ms) {
+        s32 delta = hotkey_update(state, cfg, buttons, t * MS);
+        if (delta != 0) {
+            printf("  %5llu ms  %+d\n", (unsigned long long)t, delta);
+            total += delta;
+            ++*steps;
+        }
+    }
+    return total;
+}
+
+int main(int argc, char **argv) {
+    HotkeyConfig cfg = { 0, 1ULL << 13, 1ULL << 15, HOTKEY_DEFAULT_STEP, HOTKEY_DEFAULT_POLL_MS };
+    const char *combo = argc > 1 ? argv[1] : "ZL+ZR";
+    if (!hotkey_parse_buttons(combo, &cfg.modifiers) || cfg.modifiers == 0) {
+        fprintf(stderr, "无效的组合键: %s\n", combo);
+        return 2;
+    }
+    printf("修饰键 %s = 0x%llx\n", combo, (unsigned long long)cfg.modifiers);
+
+    u64 mask;
+    expect(hotkey_parse_buttons(" zl + Zr ", &mask) && mask == ((1ULL << 8) | (1ULL << 9)), "解析 \" zl + Zr \"");
+    expect(hotkey_parse_buttons("none", &mask) && mask == 0, "解析 none");
+    expect(!hotkey_parse_buttons("ZL+ZZ", &mask), "拒绝未知按键");
+
+    HotkeyState state;
+    hotkey_reset(&state);
+    u64 up = cfg.modifiers | cfg.up, down = cfg.modifiers | cfg.down;
+    u32 steps;
+    s32 total;
+
+    printf("只按上（没有修饰键），按 %u ms 采样:\n", cfg.poll_ms);
+    total = run(&state, &cfg, cfg.up, 0, 1000, cfg.poll_ms, &steps);
+    expect(total == 0, "没有修饰键时不应调节");
+    run(&state, &cfg, 0, 1000, 1100, cfg.poll_ms, &steps);
+
+    // 按住 1 秒：立即一次，400 ms 后开始每 100 ms 一次（400..900 共 6 次）
+    printf("修饰键+上按住 1 秒，每 16 ms 采样（vsync）:\n");
+    total = run(&state, &cfg, up, 2000, 3000, 16, &steps);
+    expect(steps == 7 && total == 7 * cfg.step, "按住 1 秒应调节 7 次");
+    run(&state, &cfg, cfg.modifiers, 3000, 3100, 16, &steps);
+
+    // 采样间隔大于重复间隔时每次采样最多调节一次
+    printf("修饰键+下按住 1 秒，每 250 ms 采样（错过 vsync）:\n");
+    total = run(&state, &cfg, down, 4000, 5000, 250, &steps);
+    expect(steps == 3 && total == -3 * cfg.step, "每次采样最多调节一次");
+    run(&state, &cfg, 0, 5000, 5100, 16, &steps);
+
+    printf("修饰键+上下同时按住:\n");
+    total = run(&state, &cfg, up | cfg.down, 6000, 7000, 16, &steps);
+    expect(total == 0, "上下同时按住不应调节");
+
+    printf("%s\n", g_ok ? "通过" : "失败");
+    return g_ok ? 0 : 1;
+}
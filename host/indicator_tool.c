@@ -0,0 +1,128 @@
+/* 亮度指示器：在内存帧缓冲上依次画出一串亮度值，打印画面（按 INDICATOR_SCALE 缩小的字符画）并检查：
+ *   - 增量重画的结果与在空白表面上整块重画逐像素一致
+ *   - 改动的像素都在返回的范围内，值不变时不改动表面
+ *   - 首次之后的重画只覆盖变化的数字格和进度条增减的一段
+ *
+ * 用法:
+ *   dclight-indicator [--dump out.ppm] [亮度 ...]
+ * 不带亮度时运行默认序列: 65 66 70 70 100 0 5 55 50
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "render_harness.h"
+#include "gfx/font.h"
+#include "gfx/indicator.h"
+
+#define PIXELS (INDICATOR_WIDTH * INDICATOR_HEIGHT)
+
+// 在 mem 上画一次，返回重画范围，linear 为画完后的线性像素
+static IndicatorDamage draw(MemFramebuffer *mem, IndicatorView *view, s32 value, u16 *linear) {
+    renderBind(&mem->fb);
+    startFrame();
+    BlSurface s = currentSurface();
+    IndicatorDamage dirty = indicator_draw(view, &s, value);
+    endFrame(true);
+    renderBind(NULL);
+    mem_framebuffer_deswizzle(mem, linear);
+    return dirty;
+}
+
+static bool in_rect(const IndicatorRect *r, u32 x, u32 y) {
+    return (s32)x >= r->x && (s32)x < r->x + r->w && (s32)y >= r->y && (s32)y < r->y + r->h;
+}
+
+// 每个字符对应 INDICATOR_SCALE x INDICATOR_SCALE 个像素（取左上角）
+static void print_panel(const u16 *linear) {
+    for (u32 y = 0; y < INDICATOR_HEIGHT; y += INDICATOR_SCALE) {
+        char line[INDICATOR_WIDTH / INDICATOR_SCALE + 2];
+        u32 n = 0;
+        for (u32 x = 0; x < INDICATOR_WIDTH; x += INDICATOR_SCALE) {
+            u16 px = linear[y * INDICATOR_WIDTH + x];
+            u32 luma = px & 0xF;
+            line[n++] = luma >= 0xC ? '#' : luma >= 0x3 ? '-' : ' ';
+        }
+        line[n] = '\0';
+        printf("  |%s|\n", line);
+    }
+}
+
+int main(int argc, char **argv) {
+    static const s32 defaults[] = { 65, 66, 70, 70, 100, 0, 5, 55, 50 };
+    const char *dump = NULL;
+    int first = 1;
+    if (first + 1 < argc && strcmp(argv[first], "--dump") == 0) {
+        dump = argv[first + 1];
+        first += 2;
+    }
+    s32 values[64];
+    int count = 0;
+    for (int i = first; i < argc && count < 64; ++i) values[count++] = atoi(argv[i]);
+    if (count == 0) {
+        count = (int)(sizeof(defaults) / sizeof(defaults[0]));
+        memcpy(values, defaults, sizeof(defaults));
+    }
+
+    // 表中的每个可打印字符都有字形（空格除外）
+    for (char c = '!'; c <= '~'; ++c) {
+        const u8 *g = font_glyph(c);
+        bool lit = false;
+        for (int r = 0; r < FONT_GLYPH_HEIGHT; ++r) lit |= g[r] != 0;
+        if (!lit && ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))) {
+            fprintf(stderr, "错误: 字符 '%c' 没有字形\n", c);
+            g_ok = false;
+        }
+    }
+
+    MemFramebuffer live, ref;
+    if (!mem_framebuffer_create(&live, INDICATOR_WIDTH, INDICATOR_HEIGHT)
+        || !mem_framebuffer_create(&ref, INDICATOR_WIDTH, INDICATOR_HEIGHT)) {
+        fprintf(stderr, "内存不足\n");
+        return 1;
+    }
+    static u16 before[PIXELS], after[PIXELS], expected[PIXELS];
+    IndicatorView view;
+    indicator_invalidate(&view);
+    mem_framebuffer_deswizzle(&live, before);
+
+    for (int i = 0; i < count; ++i) {
+        s32 value = values[i];
+        bool full = !view.drawn;
+        IndicatorDamage dirty = draw(&live, &view, value, after);
+
+        IndicatorView fresh;
+        indicator_invalidate(&fresh);
+        memset(ref.pixels, 0, ref.size);
+        draw(&ref, &fresh, value, expected);
+
+        u32 changed = 0;
+        bool outside = false;
+        for (u32 y = 0; y < INDICATOR_HEIGHT; ++y) {
+            for (u32 x = 0; x < INDICATOR_WIDTH; ++x) {
+                u32 p = y * INDICATOR_WIDTH + x;
+                if (before[p] == after[p]) continue;
+                changed++;
+                outside |= !in_rect(&dirty.bounds, x, y);
+            }
+        }
+        printf("%3d  范围 (%d,%d) %dx%d，重画 %u 个像素，%u 个像素变化\n", value, dirty.bounds.x, dirty.bounds.y,
+               dirty.bounds.w, dirty.bounds.h, dirty.pixels, changed);
+        expect(memcmp(after, expected, sizeof(after)) == 0, "增量重画应与整块重画一致");
+        expect(!outside, "改动的像素应在重画范围内");
+        if (i > 0 && values[i - 1] == value) expect(dirty.pixels == 0 && changed == 0, "值不变时不应改动表面");
+        if (!full) expect(dirty.pixels < PIXELS / 4, "增量重画应只覆盖数字格和进度条的一段");
+        memcpy(before, after, sizeof(before));
+    }
+    print_panel(after);
+
+    if (dump && !write_ppm(dump, after, INDICATOR_WIDTH, INDICATOR_HEIGHT)) {
+        fprintf(stderr, "无法写入 %s\n", dump);
+        g_ok = false;
+    }
+    mem_framebuffer_destroy(&live);
+    mem_framebuffer_destroy(&ref);
+    printf("%s\n", g_ok ? "通过" : "失败");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,351 @@
+/* DClight IPC 协议的 Linux 替身：同一份 service.c 命令处理跑在 Unix 域套接字之上
+ *
+ * 帧格式与 CMIF 数据区一致，前面加一个 u32 长度：
+ *   请求: u32 len | u32 magic 'SFCI' | u32 version | u32 cmd | u32 token | 参数
+ *   回复: u32 len | u32 magic 'SFCO' | u32 version | u32 result | u32 token | 返回值
+ *
+ * 用法:
+ *   dclight-standin serve [socket]           启动替身服务
+ *   dclight-standin [-s socket] <命令> [参数]  作为客户端发送一条命令
+ *     命令: version | get-brightness | set-brightness N | get-alpha | set-alpha N | status | reload | memory | boot | metrics
+ */
+#include <errno.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ipc/service.h"
+
+#define STANDIN_DEFAULT_SOCKET "/tmp/dclight.sock"
+#define CMIF_IN_MAGIC  0x49434653 // "SFCI"
+#define CMIF_OUT_MAGIC 0x4F434653 // "SFCO"
+#define FRAME_MAX 0x200
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 value; // 请求为 cmd，回复为 result
+    u32 token;
+} FrameHeader;
+
+static bool g_pending = false;
+static u32 g_steps = 0;     // 模拟的主循环迭代次数
+static u32 g_presented = 0; // 其中暗化等级变化、需要提交的次数
+
+static void standin_notify(void *arg) {
+    (void)arg;
+    g_pending = true;
+}
+
+// 模拟 sysmodule 主循环的一次迭代：取走请求并发布状态
+static void standin_overlay_step(void) {
+    static DClightStatus state = {
+        .api_version = DCLIGHT_IPC_API_VERSION,
+        .brightness = DCLIGHT_BRIGHTNESS_NONE,
+        .presented_alpha = DCLIGHT_ALPHA_NONE,
+        .flags = DClightStatusFlag_GfxReady,
+    };
+
+    ServiceRequest req;
+    if (service_take_request(&req)) {
+        if (req.kind == ServiceRequest_Brightness) {
+            state.brightness = (s32)req.value;
+            state.alpha = dclightBrightnessToAlpha(req.value);
+        } else {
+            state.brightness = DCLIGHT_BRIGHTNESS_NONE;
+            state.alpha = req.value;
+        }
+        state.flags |= DClightStatusFlag_FromIpc;
+        printf("[overlay] 应用 brightness=%d alpha=%u\n", state.brightness, state.alpha);
+    }
+    g_steps++;
+    if (state.presented_alpha != state.alpha) g_presented++;
+    state.presented_alpha = state.alpha;
+    service_publish_status(&state);
+    g_pending = false;
+}
+
+// 用宿主进程自己的 malloc 统计代替 sysmodule 的内存统计
+static void standin_memory_stats(DClightMemoryStats *out) {
+    struct mallinfo2 mi = mallinfo2();
+    out->heap_used = (u32)mi.uordblks;
+    out->heap_peak = (u32)mi.arena;
+}
+
+// 替身服务自己的启动计时：进程开始运行和开始监听套接字两步
+static u64 g_startUs = 0;
+static u64 g_listenUs = 0;
+
+static u64 monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000ULL + (u64)ts.tv_nsec / 1000;
+}
+
+static void standin_boot_trace(DClightBootTrace *out) {
+    out->count = 2;
+    out->start_ms = (u32)(g_startUs / 1000);
+    out->entries[0] = (DClightBootTraceEntry){ .step = DClightBootStep_Heap };
+    out->entries[1] = (DClightBootTraceEntry){
+        .step = DClightBootStep_Ipc,
+        .duration_us = (u32)(g_listenUs - g_startUs),
+    };
+}
+
+// 替身服务只有主循环迭代和提交次数可以报告
+static void standin_metrics(DClightMetrics *out) {
+    out->uptime_s = (u32)((monotonic_us() - g_startUs) / 1000000ULL);
+    out->wakeups = g_steps;
+    out->frames_presented = g_presented;
+    out->frames_skipped = g_steps - g_presented;
+}
+
+static bool read_full(int fd, void *buf, size_t size) {
+    u8 *p = buf;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool write_full(int fd, const void *buf, size_t size) {
+    const u8 *p = buf;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static bool send_frame(int fd, u32 magic, u32 value, const void *data, size_t size) {
+    u8 frame[FRAME_MAX];
+    FrameHeader header = { magic, 0, value, 0 };
+    u32 len = (u32)(sizeof(header) + size);
+    if (len > sizeof(frame)) return false;
+    memcpy(frame, &header, sizeof(header));
+    if (size > 0) memcpy(frame + sizeof(header), data, size);
+    return write_full(fd, &len, sizeof(len)) && write_full(fd, frame, len);
+}
+
+static bool recv_frame(int fd, FrameHeader *header, u8 *data, size_t *size) {
+    u32 len;
+    u8 frame[FRAME_MAX];
+    if (!read_full(fd, &len, sizeof(len))) return false;
+    if (len < sizeof(*header) || len > sizeof(frame)) return false;
+    if (!read_full(fd, frame, len)) return false;
+    memcpy(header, frame, sizeof(*header));
+    *size = len - sizeof(*header);
+    memcpy(data, frame + sizeof(*header), *size);
+    return true;
+}
+
+static int socket_open(const char *path, bool server) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+
+    int rc;
+    if (server) {
+        unlink(path);
+        rc = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+        if (rc == 0) rc = listen(fd, DCLIGHT_IPC_MAX_SESSIONS);
+    } else {
+        rc = connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+    }
+    if (rc != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void serve_session(int fd) {
+    FrameHeader header;
+    u8 in[FRAME_MAX], out[FRAME_MAX];
+    size_t in_size, out_size;
+
+    while (recv_frame(fd, &header, in, &in_size)) {
+        Result rc;
+        out_size = 0;
+        if (header.magic != CMIF_IN_MAGIC) {
+            rc = MAKERESULT(Module_Libnx, LibnxError_BadInput);
+        } else {
+            rc = service_dispatch(header.value, in, in_size, out, &out_size);
+        }
+        printf("[ipc] cmd=%u -> 0x%x\n", header.value, rc);
+
+        if (g_pending) standin_overlay_step();
+        if (!send_frame(fd, CMIF_OUT_MAGIC, rc, out, R_SUCCEEDED(rc) ? out_size : 0)) break;
+    }
+}
+
+static int run_server(const char *path) {
+    int listen_fd = socket_open(path, true);
+    if (listen_fd < 0) {
+        fprintf(stderr, "无法监听 %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    service_init(standin_notify, NULL);
+    service_set_memory_source(standin_memory_stats);
+    service_set_boot_trace_source(standin_boot_trace);
+    service_set_metrics_source(standin_metrics);
+    g_listenUs = monotonic_us();
+    standin_overlay_step();
+    printf("DClight 替身服务已启动: %s\n", path);
+    fflush(stdout);
+
+    for (;;) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        serve_session(fd);
+        close(fd);
+        fflush(stdout);
+    }
+
+    close(listen_fd);
+    unlink(path);
+    return 0;
+}
+
+static void print_histogram(const char *name, const DClightHistogram *h) {
+    u32 count = dclightHistogramCount(h);
+    printf("%-14s n=%u avg=%uus max=%uus |", name, count, count ? (u32)(h->total_us / count) : 0, h->max_us);
+    for (u32 i = 0; i < DCLIGHT_HISTOGRAM_BUCKETS; ++i) {
+        u32 limit = dclightHistogramLimitUs(i);
+        if (limit) printf(" <%u:%u", limit, h->buckets[i]);
+        else printf(" >=%u:%u", dclightHistogramLimitUs(i - 1), h->buckets[i]);
+    }
+    printf("\n");
+}
+
+static void print_metrics(const DClightMetrics *m) {
+    printf("uptime=%us wakeups=%u (%u/min) presented=%u skipped=%u\n",
+           m->uptime_s, m->wakeups, m->wakeups_per_minute, m->frames_presented, m->frames_skipped);
+    printf("io: config_checks=%u config_reads=%u log_writes=%u title_polls=%u\n",
+           m->config_checks, m->config_reads, m->log_writes, m->title_polls);
+    print_histogram("config_reload", &m->config_reload);
+    print_histogram("vsync_wait", &m->vsync_wait);
+    print_histogram("fb_begin", &m->fb_begin);
+    print_histogram("fb_end", &m->fb_end);
+}
+
+static int run_client(const char *path, const char *cmd, const char *arg) {
+    static const struct {
+        const char *name;
+        u32 cmd;
+        bool has_arg;
+    } commands[] = {
+        { "version",        DClightIpcCmd_GetApiVersion, false },
+        { "get-brightness", DClightIpcCmd_GetBrightness, false },
+        { "set-brightness", DClightIpcCmd_SetBrightness, true  },
+        { "get-alpha",      DClightIpcCmd_GetAlpha,      false },
+        { "set-alpha",      DClightIpcCmd_SetAlpha,      true  },
+        { "status",         DClightIpcCmd_GetStatus,     false },
+        { "reload",         DClightIpcCmd_ReloadConfig,  false },
+        { "memory",         DClightIpcCmd_GetMemoryStats, false },
+        { "boot",           DClightIpcCmd_GetBootTrace,   false },
+        { "metrics",        DClightIpcCmd_GetMetrics,     false },
+    };
+
+    int index = -1;
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); ++i) {
+        if (strcmp(cmd, commands[i].name) == 0) index = (int)i;
+    }
+    if (index < 0 || (commands[index].has_arg && arg == NULL)) {
+        fprintf(stderr, "未知命令或缺少参数: %s\n", cmd);
+        return 2;
+    }
+
+    int fd = socket_open(path, false);
+    if (fd < 0) {
+        fprintf(stderr, "无法连接 %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    u32 value = arg ? (u32)strtoul(arg, NULL, 0) : 0;
+    FrameHeader header;
+    u8 out[FRAME_MAX];
+    size_t out_size = 0;
+    bool ok = send_frame(fd, CMIF_IN_MAGIC, commands[index].cmd, &value, commands[index].has_arg ? sizeof(value) : 0)
+           && recv_frame(fd, &header, out, &out_size);
+    close(fd);
+
+    if (!ok || header.magic != CMIF_OUT_MAGIC) {
+        fprintf(stderr, "通信失败\n");
+        return 1;
+    }
+    if (R_FAILED(header.value)) {
+        printf("result=0x%x (module %u, desc %u)\n", header.value, R_MODULE(header.value), R_DESCRIPTION(header.value));
+        return 1;
+    }
+
+    if (commands[index].cmd == DClightIpcCmd_GetStatus && out_size >= sizeof(DClightStatus)) {
+        DClightStatus st;
+        memcpy(&st, out, sizeof(st));
+        printf("api=%u brightness=%d alpha=%u presented=%d flags=0x%x reloads=%u\n",
+               st.api_version, st.brightness, st.alpha,
+               st.presented_alpha == DCLIGHT_ALPHA_NONE ? -1 : (int)st.presented_alpha,
+               st.flags, st.config_reloads);
+    } else if (commands[index].cmd == DClightIpcCmd_GetMemoryStats && out_size >= sizeof(DClightMemoryStats)) {
+        DClightMemoryStats ms;
+        memcpy(&ms, out, sizeof(ms));
+        printf("heap=%u used=%u peak=%u libnx_allocs=%u live=%u bytes=%u peak=%u nv_tmem=%u fb=%u x%u\n",
+               ms.heap_size, ms.heap_used, ms.heap_peak, ms.libnx_allocs, ms.libnx_live, ms.libnx_bytes,
+               ms.libnx_peak, ms.nv_tmem_size, ms.framebuffer_bytes, ms.framebuffer_count);
+    } else if (commands[index].cmd == DClightIpcCmd_GetBootTrace && out_size >= sizeof(DClightBootTrace)) {
+        DClightBootTrace bt;
+        memcpy(&bt, out, sizeof(bt));
+        printf("start=%ums\n", bt.start_ms);
+        u32 at = 0;
+        for (u32 i = 0; i < bt.count && i < DCLIGHT_BOOT_TRACE_MAX; ++i) {
+            at += bt.entries[i].duration_us;
+            printf("%-12s +%7uus  at %7uus\n", dclightBootStepName(bt.entries[i].step), bt.entries[i].duration_us, at);
+        }
+    } else if (commands[index].cmd == DClightIpcCmd_GetMetrics && out_size >= sizeof(DClightMetrics)) {
+        DClightMetrics m;
+        memcpy(&m, out, sizeof(m));
+        print_metrics(&m);
+    } else if (out_size >= sizeof(u32)) {
+        s32 v;
+        memcpy(&v, out, sizeof(v));
+        printf("%d\n", v);
+    } else {
+        printf("ok\n");
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = STANDIN_DEFAULT_SOCKET;
+    int argi = 1;
+    g_startUs = monotonic_us();
+
+    if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+        return run_server(argc > 2 ? argv[2] : path);
+    }
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        path = argv[2];
+        argi = 3;
+    }
+    if (argi >= argc) {
+        fprintf(stderr, "用法: %s serve [socket] | [-s socket] <命令> [参数]\n", argv[0]);
+        return 2;
+    }
+    return run_client(path, argv[argi], argi + 1 < argc ? argv[argi + 1] : NULL);
+}
@@ -0,0 +1,168 @@
+/* DClight 共享内存信箱的 Linux 替身：用 POSIX 共享内存代替 svcCreateSharedMemory
+ *
+ * 用法:
+ *   dclight-mailbox overlay            模拟覆盖层：创建信箱，generation 变化时应用并发布状态
+ *   dclight-mailbox set <亮度> [ramp_ms] 模拟 NRO：提交新的亮度
+ *   dclight-mailbox status             读取覆盖层发布的状态
+ *   dclight-mailbox stress [次数]       一个写进程、一个读进程并发压测 seqlock，统计撕裂读
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <dclight/mailbox.h>
+
+#define MAILBOX_SHM_NAME "/dclight-mailbox"
+
+static DClightMailbox *mailbox_map(bool create) {
+    int fd = shm_open(MAILBOX_SHM_NAME, create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+    if (fd < 0) {
+        perror("shm_open");
+        return NULL;
+    }
+    if (create && ftruncate(fd, DCLIGHT_MAILBOX_SIZE) != 0) {
+        perror("ftruncate");
+        close(fd);
+        return NULL;
+    }
+    void *addr = mmap(NULL, DCLIGHT_MAILBOX_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        perror("mmap");
+        return NULL;
+    }
+
+    DClightMailbox *mb = addr;
+    if (create) {
+        memset(mb, 0, DCLIGHT_MAILBOX_SIZE);
+        mb->magic = DCLIGHT_MAILBOX_MAGIC;
+        mb->version = DCLIGHT_MAILBOX_VERSION;
+        mb->control.brightness = DCLIGHT_BRIGHTNESS_NONE;
+    } else if (mb->magic != DCLIGHT_MAILBOX_MAGIC || mb->version != DCLIGHT_MAILBOX_VERSION) {
+        fprintf(stderr, "信箱格式不匹配\n");
+        munmap(addr, DCLIGHT_MAILBOX_SIZE);
+        return NULL;
+    }
+    return mb;
+}
+
+static void sleep_us(long us) {
+    struct timespec ts = { us / 1000000, (us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+// 与 sysmodule 主循环相同：只在 generation 变化时读取快照并应用
+static int run_overlay(void) {
+    DClightMailbox *mb = mailbox_map(true);
+    if (!mb) return 1;
+
+    u32 last_generation = 0;
+    DClightMailboxStatus st = { .brightness = DCLIGHT_BRIGHTNESS_NONE, .presented_alpha = DCLIGHT_ALPHA_NONE };
+    dclightMailboxStatusStore(mb, &st);
+    printf("覆盖层替身已启动: shm %s\n", MAILBOX_SHM_NAME);
+    fflush(stdout);
+
+    for (;;) {
+        if (dclightMailboxControlGeneration(mb) != last_generation) {
+            DClightMailboxControl ctrl;
+            if (dclightMailboxControlLoad(mb, &ctrl)) {
+                last_generation = ctrl.generation;
+                st.generation = ctrl.generation;
+                st.brightness = ctrl.brightness;
+                st.alpha = ctrl.brightness >= 0 ? dclightBrightnessToAlpha((u32)ctrl.brightness) : ctrl.alpha;
+                st.presented_alpha = st.alpha;
+                st.flags = DClightStatusFlag_GfxReady | DClightStatusFlag_FromIpc;
+                dclightMailboxStatusStore(mb, &st);
+                printf("[overlay] gen=%u brightness=%d alpha=%u ramp=%ums\n",
+                       ctrl.generation, ctrl.brightness, st.alpha, ctrl.ramp_ms);
+                fflush(stdout);
+            }
+        }
+        // 设备上由 doorbell 事件唤醒，这里用短暂休眠代替
+        sleep_us(1000);
+    }
+    return 0;
+}
+
+static int run_set(int argc, char *argv[]) {
+    if (argc < 1) return 2;
+    DClightMailbox *mb = mailbox_map(false);
+    if (!mb) return 1;
+
+    DClightMailboxControl ctrl = {
+        .generation = dclightMailboxControlGeneration(mb) + 1,
+        .brightness = atoi(argv[0]),
+        .ramp_ms = argc > 1 ? (u32)atoi(argv[1]) : 0,
+    };
+    dclightMailboxControlStore(mb, &ctrl);
+    printf("gen=%u\n", ctrl.generation);
+    return 0;
+}
+
+static int run_status(void) {
+    DClightMailbox *mb = mailbox_map(false);
+    if (!mb) return 1;
+
+    DClightMailboxStatus st;
+    if (!dclightMailboxStatusLoad(mb, &st)) {
+        fprintf(stderr, "读取状态失败（写者未完成）\n");
+        return 1;
+    }
+    printf("gen=%u brightness=%d alpha=%u presented=%d flags=0x%x\n", st.generation, st.brightness, st.alpha,
+           st.presented_alpha == DCLIGHT_ALPHA_NONE ? -1 : (int)st.presented_alpha, st.flags);
+    return 0;
+}
+
+// 写者让 brightness/alpha/ramp_ms 都由 generation 推出，读者据此检查快照是否一致
+static int run_stress(long iterations) {
+    DClightMailbox *mb = mailbox_map(true);
+    if (!mb) return 1;
+
+    pid_t writer = fork();
+    if (writer == 0) {
+        for (long i = 1; i <= iterations; ++i) {
+            u32 g = (u32)i;
+            DClightMailboxControl ctrl = { .generation = g, .brightness = (s32)(g % 101), .alpha = g * 3, .ramp_ms = g * 7 };
+            dclightMailboxControlStore(mb, &ctrl);
+        }
+        _exit(0);
+    }
+
+    long reads = 0, torn = 0, failed = 0;
+    u32 last = 0;
+    while (last < (u32)iterations) {
+        DClightMailboxControl ctrl;
+        if (!dclightMailboxControlLoad(mb, &ctrl)) {
+            failed++;
+            continue;
+        }
+        reads++;
+        u32 g = ctrl.generation;
+        if (g == 0) continue;
+        if (ctrl.brightness != (s32)(g % 101) || ctrl.alpha != g * 3 || ctrl.ramp_ms != g * 7 || g < last) torn++;
+        last = g;
+    }
+    waitpid(writer, NULL, 0);
+    shm_unlink(MAILBOX_SHM_NAME);
+
+    printf("reads=%ld torn=%ld retries_exhausted=%ld\n", reads, torn, failed);
+    return torn == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "用法: %s overlay | set <亮度> [ramp_ms] | status | stress [次数]\n", argv[0]);
+        return 2;
+    }
+    if (strcmp(argv[1], "overlay") == 0) return run_overlay();
+    if (strcmp(argv[1], "set") == 0) return run_set(argc - 2, argv + 2);
+    if (strcmp(argv[1], "status") == 0) return run_status();
+    if (strcmp(argv[1], "stress") == 0) return run_stress(argc > 2 ? atol(argv[2]) : 1000000);
+    fprintf(stderr, "未知命令: %s\n", argv[1]);
+    return 2;
+}
@@ -0,0 +1,134 @@
+/* 电源状态模拟：用脚本代替 PSC 模块，把事件逐个交给 power_dispatch，
+ * 按 sysmodule 主循环的做法处理动作，并检查：
+ *   - 每个请求都在动作完成之后确认，且只确认一次
+ *   - 睡眠期间没有任何定时器，醒来前不会绘制也不会访问 SD 卡
+ *   - 醒来后只重新提交一帧，并且只重新设置按需的定时器，不留下固定间隔的轮询
+ *
+ * 用法:
+ *   dclight-power [事件 ...]   事件: sleep | wake | shutdown | other | tick
+ * 不带参数时运行默认脚本: tick sleep sleep tick wake tick wake sleep shutdown wake tick
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "power.h"
+#include "check.h"
+
+typedef struct {
+    const PowerEvent *events;
+    u32 count;
+    u32 next;
+    u32 taken;
+    u32 acked;
+    bool actionDone; // 当前请求的动作是否已经执行（用于检查确认的顺序）
+} ScriptSource;
+
+// 模拟的主循环状态
+typedef struct {
+    bool timerArmed;  // 按需的定时器（如前台应用检查）；睡眠时必须全部取消
+    u32 presents;
+    u32 io;
+} SimLoop;
+
+static ScriptSource g_script;
+static SimLoop g_loop;
+
+static bool script_take(void *ctx, PowerEvent *out) {
+    ScriptSource *s = ctx;
+    if (s->next >= s->count) return false;
+    *out = s->events[s->next++];
+    s->taken++;
+    s->actionDone = false;
+    return true;
+}
+
+static void script_ack(void *ctx) {
+    ScriptSource *s = ctx;
+    s->acked++;
+    expect(s->acked == s->taken, "每次确认应恰好对应一个请求");
+}
+
+static void sim_apply(PowerAction action, void *arg) {
+    SimLoop *loop = arg;
+    if (action == PowerAction_Suspend) {
+        loop->timerArmed = false;
+        loop->io++; // 写出日志
+    } else if (action == PowerAction_Resume) {
+        loop->presents++;
+        loop->io++; // 检查一次配置文件
+        loop->timerArmed = true;
+    }
+    g_script.actionDone = true;
+}
+
+static const char *action_name(PowerAction action) {
+    switch (action) {
+        case PowerAction_Suspend: return "suspend";
+        case PowerAction_Resume:  return "resume";
+        default:                  return "-";
+    }
+}
+
+static bool parse_event(const char *text, PowerEvent *out, bool *tick) {
+    static const struct { const char *name; PowerEvent event; } names[] = {
+        { "sleep", PowerEvent_Sleep }, { "wake", PowerEvent_Wake },
+        { "shutdown", PowerEvent_Shutdown }, { "other", PowerEvent_None },
+    };
+    *tick = strcmp(text, "tick") == 0;
+    if (*tick) return true;
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(text, names[i].name) == 0) {
+            *out = names[i].event;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    static const char *const defaults[] = {
+        "tick", "sleep", "sleep", "tick", "wake", "tick", "wake", "sleep", "shutdown", "wake", "tick",
+    };
+    const char *const *script = argc > 1 ? (const char *const *)&argv[1] : defaults;
+    int count = argc > 1 ? argc - 1 : (int)(sizeof(defaults) / sizeof(defaults[0]));
+
+    PowerMonitor pm;
+    power_monitor_init(&pm);
+    PowerSource source = { &g_script, script_take, script_ack };
+    g_loop.timerArmed = true;
+
+    for (int i = 0; i < count; ++i) {
+        PowerEvent event;
+        bool tick;
+        if (!parse_event(script[i], &event, &tick)) {
+            fprintf(stderr, "未知事件: %s\n", script[i]);
+            return 2;
+        }
+
+        if (tick) {
+            // 时间流逝：睡眠期间没有定时器可以唤醒主循环
+            if (power_monitor_suspended(&pm)) {
+                expect(!g_loop.timerArmed, "睡眠期间不应有定时器");
+            } else if (g_loop.timerArmed) {
+                g_loop.io++;
+            }
+            printf("%-9s suspended=%d timer=%d presents=%u io=%u\n", "tick",
+                   power_monitor_suspended(&pm), g_loop.timerArmed, g_loop.presents, g_loop.io);
+            continue;
+        }
+
+        g_script.events = &event;
+        g_script.count = 1;
+        g_script.next = 0;
+        u32 presents = g_loop.presents;
+        PowerAction action = power_dispatch(&pm, &source, sim_apply, &g_loop);
+        expect(action == PowerAction_None || g_script.actionDone, "动作应在确认之前执行");
+        expect(g_loop.presents - presents <= 1, "醒来后应只提交一帧");
+        printf("%-9s -> %-8s suspended=%d timer=%d presents=%u io=%u\n", script[i], action_name(action),
+               power_monitor_suspended(&pm), g_loop.timerArmed, g_loop.presents, g_loop.io);
+    }
+
+    printf("睡眠 %u 次，确认 %u/%u 个请求\n", pm.sleeps, g_script.acked, g_script.taken);
+    expect(g_script.acked == g_script.taken, "所有请求都应被确认");
+    return g_ok ? 0 : 1;
+}
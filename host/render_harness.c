@@ -0,0 +1,68 @@
+/* 宿主渲染环境 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "render_harness.h"
+
+static void *mem_begin(void *ctx) {
+    MemFramebuffer *mem = ctx;
+    return mem->pixels;
+}
+
+static void mem_end(void *ctx, bool vsyncAligned) {
+    MemFramebuffer *mem = ctx;
+    (void)vsyncAligned;
+    mem->frames++;
+}
+
+bool mem_framebuffer_create(MemFramebuffer *mem, u32 width, u32 height) {
+    memset(mem, 0, sizeof(*mem));
+    u32 stride = (width * 2 + 63) & ~63u;
+    u32 alignedHeight = (height + BL_BLOCK_HEIGHT - 1) & ~(BL_BLOCK_HEIGHT - 1);
+    mem->size = (size_t)stride * alignedHeight;
+    mem->pixels = aligned_alloc(4096, (mem->size + 4095) & ~(size_t)4095);
+    if (mem->pixels == NULL) return false;
+    memset(mem->pixels, 0, mem->size);
+
+    mem->fb = (RenderFramebuffer){
+        .ctx = mem,
+        .width = width,
+        .height = height,
+        .stride = stride,
+        .begin = mem_begin,
+        .end = mem_end,
+    };
+    return true;
+}
+
+void mem_framebuffer_destroy(MemFramebuffer *mem) {
+    free(mem->pixels);
+    mem->pixels = NULL;
+}
+
+void mem_framebuffer_deswizzle(const MemFramebuffer *mem, u16 *out) {
+    BlSurface s = { mem->pixels, mem->fb.width, mem->fb.height, mem->fb.stride, mem->fb.format };
+    for (u32 y = 0; y < s.height; ++y) {
+        for (u32 x = 0; x < s.width; ++x) {
+            out[(size_t)y * s.width + x] = ((const u16 *)s.pixels)[bl_pixel_index(&s, x, y)];
+        }
+    }
+}
+
+bool write_ppm(const char *path, const u16 *linear, u32 width, u32 height) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+    fprintf(f, "P6\n%u %u\n255\n", width, height);
+    for (size_t i = 0; i < (size_t)width * height; ++i) {
+        u16 px = linear[i];
+        u32 a = px >> 12;
+        u8 rgb[3] = {
+            (u8)(((px >> 0) & 0xF) * 17 * a / 15),
+            (u8)(((px >> 4) & 0xF) * 17 * a / 15),
+            (u8)(((px >> 8) & 0xF) * 17 * a / 15),
+        };
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+    return fclose(f) == 0;
+}
@@ -0,0 +1,22 @@
+/* 宿主渲染环境：用一块内存实现 RenderFramebuffer，使 source/gfx 的绘制路径可以在 PC 上运行 */
+#pragma once
+
+#include <stddef.h>
+#include "gfx/render.h"
+
+typedef struct {
+    RenderFramebuffer fb;
+    u16 *pixels;
+    size_t size;
+    u32 frames; // 已提交的帧数
+} MemFramebuffer;
+
+// 与 framebufferCreate 相同的对齐：stride 按 64 字节，高度按块高（128 行）
+bool mem_framebuffer_create(MemFramebuffer *mem, u32 width, u32 height);
+void mem_framebuffer_destroy(MemFramebuffer *mem);
+
+// 块线性 -> 线性（width * height 个像素，逐行紧密排列）
+void mem_framebuffer_deswizzle(const MemFramebuffer *mem, u16 *out);
+
+// 线性 RGBA4444 图像写成 PPM（按 alpha 叠加到黑底上，便于直接查看）
+bool write_ppm(const char *path, const u16 *linear, u32 width, u32 height);
@@ -0,0 +1,86 @@
+/* 亮度计划模拟：按 [schedule] 节的写法给出时间点，打印一天内主循环醒来的时刻和每次的亮度/alpha，
+ * 并与逐秒计算的结果对比，确认 schedule_next_change 给出的正是 alpha 第一次变化的时刻
+ * --alpha8 按 RGBA8888 实际绘制的 0-255 alpha 计算和校验（否则按 0-15）
+ *
+ * 用法:
+ *   dclight-schedule [--interpolate] [--alpha8] HH:MM=亮度 ...
+ * 例如:
+ *   dclight-schedule --interpolate --alpha8 07:00=100 20:00=100 23:00=30
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dclight/ipc.h>
+#include "schedule.h"
+
+static bool g_alpha8 = false;
+
+static u32 alpha_at(const Schedule *s, u32 second) {
+    u32 brightness = (u32)schedule_brightness_at(s, second);
+    return g_alpha8 ? dclightBrightnessToAlpha8(brightness) : dclightBrightnessToAlpha(brightness);
+}
+
+int main(int argc, char **argv) {
+    Schedule schedule;
+    schedule_reset(&schedule);
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--interpolate") == 0) {
+            schedule.interpolate = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--alpha8") == 0) {
+            g_alpha8 = true;
+            continue;
+        }
+        char key[16];
+        const char *eq = strchr(argv[i], '=');
+        u32 second;
+        if (eq == NULL || (size_t)(eq - argv[i]) >= sizeof(key)) {
+            fprintf(stderr, "无效的时间点: %s\n", argv[i]);
+            return 2;
+        }
+        memcpy(key, argv[i], (size_t)(eq - argv[i]));
+        key[eq - argv[i]] = '\0';
+        if (!schedule_parse_time(key, &second) || !schedule_add(&schedule, second, atoi(eq + 1))) {
+            fprintf(stderr, "无效的时间点: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (schedule.count == 0) {
+        fprintf(stderr, "用法: %s [--interpolate] [--alpha8] HH:MM=亮度 ...\n", argv[0]);
+        return 2;
+    }
+
+    // 从 00:00 起按 schedule_next_change 跳到下一次醒来，直到跨过一天
+    u32 wakeups = 0;
+    u32 now = 0;
+    bool ok = true;
+    for (;;) {
+        u32 alpha = alpha_at(&schedule, now);
+        printf("%02u:%02u:%02u  brightness=%3d  alpha=%3u\n",
+               now / 3600, now / 60 % 60, now % 60, schedule_brightness_at(&schedule, now), alpha);
+
+        u32 wait = schedule_next_change(&schedule, now, g_alpha8);
+
+        // 逐秒校验：等待期间 alpha 不变，醒来时要么已经变化，要么到达区间终点
+        u32 expect = 0;
+        for (u32 t = 1; t <= SCHEDULE_DAY_SECONDS; ++t) {
+            if (alpha_at(&schedule, (now + t) % SCHEDULE_DAY_SECONDS) != alpha) {
+                expect = t;
+                break;
+            }
+        }
+        if (expect == 0 ? wait != 0 : (wait == 0 || wait > expect)) {
+            fprintf(stderr, "错误: %u 秒处 next_change=%u，实际 alpha 在 %u 秒后变化\n", now, wait, expect);
+            ok = false;
+        }
+
+        if (wait == 0 || now + wait >= SCHEDULE_DAY_SECONDS) break;
+        now += wait;
+        wakeups++;
+    }
+    printf("一天醒来 %u 次\n", wakeups);
+    return ok ? 0 : 1;
+}
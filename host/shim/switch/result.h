@@ -0,0 +1,25 @@
+/* Linux 宿主构建用的 libnx Result 宏替身 */
+#pragma once
+
+#include "types.h"
+
+#define R_SUCCEEDED(res)   ((res) == 0)
+#define R_FAILED(res)      ((res) != 0)
+#define R_VALUE(res)       ((res) & 0x3FFFFF)
+#define R_MODULE(res)      ((res) & 0x1FF)
+#define R_DESCRIPTION(res) (((res) >> 9) & 0x1FFF)
+
+#define MAKERESULT(module, description) \
+    ((((module) & 0x1FF)) | ((description) & 0x1FFF) << 9)
+
+enum {
+    Module_Libnx = 345,
+};
+
+enum {
+    LibnxError_OutOfMemory = 2,
+    LibnxError_NotInitialized = 8,
+    LibnxError_NotFound = 9,
+    LibnxError_IoError = 10,
+    LibnxError_BadInput = 11,
+};
@@ -0,0 +1,27 @@
+/* Linux 宿主构建用的 libnx 类型替身，仅覆盖可移植模块用到的部分 */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t   s8;
+typedef int16_t  s16;
+typedef int32_t  s32;
+typedef int64_t  s64;
+
+typedef volatile u8  vu8;
+typedef volatile u16 vu16;
+typedef volatile u32 vu32;
+typedef volatile u64 vu64;
+
+typedef u32 Handle;
+typedef u32 Result;
+
+#define INVALID_HANDLE ((Handle)0)
+#define BIT(n) (1U << (n))
+#define NX_INLINE __attribute__((always_inline)) static inline
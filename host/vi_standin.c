@@ -0,0 +1,157 @@
+/* VI 色彩管理命令的替身：用记录调用的假显示服务驱动 CMU 暗化后端，
+ * 按 sysmodule 主循环的做法选择后端、提交 alpha，并检查：
+ *   - 只在 alpha 变化时设置 luma，且 alpha 越大 luma 越低
+ *   - 改回图层、需要图层的配置（区域/掩码）和退出时都恢复接管前的 luma
+ *   - 命令失败后退回图层，之后即使配置仍然请求 CMU 也不再尝试
+ *   - 使用 CMU 时全屏图层不在图层栈中
+ *
+ * 用法:
+ *   dclight-vi [--luma X] [--no-cmu] [--fail-set N] [步骤 ...]
+ *     步骤: layer | cmu | regions | no-regions | wake | 0-255（提交的 alpha）
+ *     --luma X      显示器当前的 luma（默认 0）
+ *     --no-cmu      GetDisplayCmuLuma 返回错误（固件不支持）
+ *     --fail-set N  第 N 次 SetDisplayCmuLuma 返回错误
+ * 不带步骤时运行默认脚本: cmu 0 68 68 255 regions 136 no-regions 136 wake 136 layer 51 cmu 204 205
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dclight/ipc.h>
+#include "check.h"
+#include "cmu.h"
+
+#define VI_CMD_GET_DISPLAY_CMU_LUMA 3216
+#define VI_CMD_SET_DISPLAY_CMU_LUMA 3217
+// 替身返回的错误码（vi 模块的 NotSupported）
+#define VI_RESULT_NOT_SUPPORTED 0x1A72
+
+typedef struct {
+    float luma;      // 显示器当前的 luma
+    bool noCmu;
+    u32 failSetAt;   // 0 表示不失败
+    u32 gets;
+    u32 sets;
+} StandinDisplay;
+
+static Result standin_get_luma(void *ctx, float *out) {
+    StandinDisplay *d = ctx;
+    d->gets++;
+    Result rc = d->noCmu ? VI_RESULT_NOT_SUPPORTED : 0;
+    printf("  vi %u GetDisplayCmuLuma -> rc=0x%x luma=%.3f\n", VI_CMD_GET_DISPLAY_CMU_LUMA, rc, d->luma);
+    if (R_SUCCEEDED(rc)) *out = d->luma;
+    return rc;
+}
+
+static Result standin_set_luma(void *ctx, float luma) {
+    StandinDisplay *d = ctx;
+    d->sets++;
+    Result rc = d->noCmu || d->sets == d->failSetAt ? VI_RESULT_NOT_SUPPORTED : 0;
+    printf("  vi %u SetDisplayCmuLuma(%.3f) -> rc=0x%x\n", VI_CMD_SET_DISPLAY_CMU_LUMA, luma, rc);
+    if (R_SUCCEEDED(rc)) d->luma = luma;
+    return rc;
+}
+
+// 模拟的主循环状态
+typedef struct {
+    DimBackend requested;
+    DimBackend backend;
+    bool regions;
+    bool layerInStack; // 全屏图层是否参与合成
+    s32 layerAlpha;    // 全屏图层上最近一次提交的 alpha
+} SimLoop;
+
+static void sim_set_backend(SimLoop *loop, DimBackend backend) {
+    if (backend == loop->backend) return;
+    loop->backend = backend;
+    if (loop->regions) return;
+    loop->layerInStack = backend == DimBackend_Layer;
+    loop->layerAlpha = -1;
+}
+
+static void sim_select(SimLoop *loop, CmuBackend *cmu) {
+    sim_set_backend(loop, cmu_backend_select(cmu, loop->requested, loop->regions));
+}
+
+static void sim_present(SimLoop *loop, CmuBackend *cmu, u8 alpha) {
+    if (loop->backend == DimBackend_Cmu) {
+        cmu_backend_present(cmu, alpha);
+        if (cmu_backend_active(cmu)) return;
+        printf("  CMU 失败，改用暗化图层\n");
+        sim_set_backend(loop, DimBackend_Layer);
+    }
+    if (!loop->regions) loop->layerAlpha = alpha;
+}
+
+int main(int argc, char **argv) {
+    static const char *const defaults[] = {
+        "cmu", "0", "68", "68", "255", "regions", "136", "no-regions", "136", "wake", "136", "layer", "51", "cmu", "204", "205",
+    };
+    StandinDisplay display = { 0 };
+    int first = 1;
+    for (; first < argc && strncmp(argv[first], "--", 2) == 0; ++first) {
+        if (strcmp(argv[first], "--no-cmu") == 0) {
+            display.noCmu = true;
+        } else if (strcmp(argv[first], "--luma") == 0 && first + 1 < argc) {
+            display.luma = strtof(argv[++first], NULL);
+        } else if (strcmp(argv[first], "--fail-set") == 0 && first + 1 < argc) {
+            display.failSetAt = (u32)atoi(argv[++first]);
+        } else {
+            fprintf(stderr, "未知选项: %s\n", argv[first]);
+            return 2;
+        }
+    }
+    const char *const *script = first < argc ? (const char *const *)&argv[first] : defaults;
+    int count = first < argc ? argc - first : (int)(sizeof(defaults) / sizeof(defaults[0]));
+
+    const float initialLuma = display.luma;
+    CmuOps ops = { &display, standin_get_luma, standin_set_luma };
+    CmuBackend cmu;
+    cmu_backend_init(&cmu, &ops);
+    SimLoop loop = { DimBackend_Layer, DimBackend_Layer, false, true, -1 };
+
+    for (int i = 0; i < count; ++i) {
+        const char *step = script[i];
+        u32 sets = display.sets;
+        float before = display.luma;
+        s32 appliedBefore = cmu.appliedAlpha;
+        if (strcmp(step, "layer") == 0 || strcmp(step, "cmu") == 0) {
+            loop.requested = step[0] == 'c' ? DimBackend_Cmu : DimBackend_Layer;
+            sim_select(&loop, &cmu);
+        } else if (strcmp(step, "regions") == 0 || strcmp(step, "no-regions") == 0) {
+            loop.regions = step[0] == 'r';
+            if (loop.regions) loop.layerInStack = false;
+            else if (loop.backend == DimBackend_Layer) loop.layerInStack = true;
+            sim_select(&loop, &cmu);
+        } else if (strcmp(step, "wake") == 0) {
+            if (loop.backend == DimBackend_Cmu) cmu_backend_resume(&cmu);
+            loop.layerAlpha = -1;
+        } else {
+            char *end;
+            long alpha = strtol(step, &end, 10);
+            if (*end != '\0' || alpha < 0 || alpha > 255) {
+                fprintf(stderr, "未知步骤: %s\n", step);
+                return 2;
+            }
+            sim_present(&loop, &cmu, (u8)alpha);
+            if (cmu_backend_active(&cmu)) {
+                expect(appliedBefore != alpha || display.sets == sets, "alpha 未变化时不应设置 luma");
+                if (appliedBefore >= 0 && alpha > appliedBefore) expect(display.luma < before, "alpha 变大时 luma 应降低");
+                expect(display.luma == cmu_alpha_to_luma(initialLuma, (u8)alpha), "luma 应由接管前的值插值得到");
+            }
+        }
+
+        if (!cmu_backend_active(&cmu)) expect(display.luma == initialLuma, "不使用 CMU 时应恢复接管前的 luma");
+        if (loop.backend == DimBackend_Cmu) expect(!loop.layerInStack, "使用 CMU 时全屏图层不应参与合成");
+        if (cmu.failed) expect(loop.backend == DimBackend_Layer, "CMU 失败后应使用图层");
+        printf("%-10s backend=%s layer=%d luma=%.3f calls=%u/%u\n", step,
+               loop.backend == DimBackend_Cmu ? "cmu" : "layer", loop.layerInStack, display.luma, display.gets, display.sets);
+    }
+
+    // 退出时交还
+    cmu_backend_release(&cmu);
+    expect(display.luma == initialLuma, "退出时应恢复接管前的 luma");
+    printf("luma %.3f -> %.3f，共 %u 次读取、%u 次设置\n", initialLuma, display.luma, display.gets, display.sets);
+    printf("%s\n", g_ok ? "通过" : "失败");
+    return g_ok ? 0 : 1;
+}
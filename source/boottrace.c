@@ -0,0 +1,60 @@
+// 启动计时
+// 各步骤按发生顺序追加到表中，耗时为与上一条记录的 tick 之差；
+// 表只由主线程追加，项写好后才以 release 发布 count，IPC 线程只读取 count 以内的项
+#include <string.h>
+#include "boottrace.h"
+#include "util/log.h"
+
+typedef struct {
+    u32 step;
+    u64 tick;
+} BootMark;
+
+static BootMark g_marks[DCLIGHT_BOOT_TRACE_MAX];
+static u32 g_count = 0;
+static u32 g_recorded = 0; // 已记录步骤的位掩码
+
+void boot_trace(DClightBootStep step) {
+    u64 tick = armGetSystemTick();
+    if ((u32)step >= DClightBootStep_Count || (g_recorded & BIT(step))) return;
+    if (g_count >= DCLIGHT_BOOT_TRACE_MAX) return;
+
+    g_recorded |= BIT(step);
+    g_marks[g_count] = (BootMark){ step, tick };
+    __atomic_store_n(&g_count, g_count + 1, __ATOMIC_RELEASE);
+}
+
+static u32 ticks_to_us(u64 ticks) {
+    return (u32)(armTicksToNs(ticks) / 1000ULL);
+}
+
+void boot_trace_read(DClightBootTrace *out) {
+    memset(out, 0, sizeof(*out));
+    u32 count = __atomic_load_n(&g_count, __ATOMIC_ACQUIRE);
+    if (count == 0) return;
+
+    u64 start = g_marks[0].tick;
+    out->count = count;
+    out->start_ms = (u32)(armTicksToNs(start) / 1000000ULL);
+    for (u32 i = 0; i < count; ++i) {
+        DClightBootTraceEntry *e = &out->entries[i];
+        e->step = (u16)g_marks[i].step;
+        e->duration_us = i > 0 ? ticks_to_us(g_marks[i].tick - g_marks[i - 1].tick) : 0;
+    }
+}
+
+void boot_trace_log(void) {
+    DClightBootTrace trace;
+    boot_trace_read(&trace);
+    if (trace.count == 0) return;
+
+    u32 total = 0;
+    for (u32 i = 0; i < trace.count; ++i) total += trace.entries[i].duration_us;
+    log_info("启动计时: 开机后 %u ms 开始运行，共 %u us", trace.start_ms, total);
+    u32 at = 0;
+    for (u32 i = 1; i < trace.count; ++i) {
+        const DClightBootTraceEntry *e = &trace.entries[i];
+        at += e->duration_us;
+        log_info("  %-12s %7u us (累计 %u us)", dclightBootStepName(e->step), e->duration_us, at);
+    }
+}
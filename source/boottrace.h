@@ -0,0 +1,21 @@
+#pragma once
+
+// 启动计时：__libnx_initheap、__appInit、gfx_init 和主循环在每一步完成后记录系统 tick，
+// 启动完成后把每一步的耗时写入日志，也可以随时通过 GetBootTrace 命令读取
+#include <switch.h>
+#include <dclight/ipc.h>
+
+// 快速启动（make FAST_START=1）：先只读全局配置并提交第一帧暗化，
+// 写日志线程、hid/time、应用监视、信箱、IPC 服务和完整配置（应用配置、计划、区域）都推迟到第一帧之后
+#ifndef DCLIGHT_FAST_START
+#  define DCLIGHT_FAST_START 0
+#endif
+
+// 记录 step 完成的时刻；每一步只记录第一次。只在主线程调用
+void boot_trace(DClightBootStep step);
+
+// 把每一步的耗时写入日志
+void boot_trace_log(void);
+
+// 当前的记录（可在任意线程调用）
+void boot_trace_read(DClightBootTrace *out);
@@ -0,0 +1,59 @@
+// 色彩管理暗化后端
+// 接管时读出当前 luma 作为基准（用户可能在系统设置之外调过），暗化只在它和下限之间插值
+#include <dclight/ipc.h>
+#include "cmu.h"
+
+void cmu_backend_init(CmuBackend *cmu, const CmuOps *ops) {
+    cmu->available = ops != NULL;
+    if (ops) cmu->ops = *ops;
+    cmu->acquired = false;
+    cmu->failed = false;
+    cmu->savedLuma = 0.0f;
+    cmu->appliedAlpha = -1;
+}
+
+float cmu_alpha_to_luma(float base, u8 alpha) {
+    return base + (CMU_LUMA_MIN - base) * (float)alpha / 255.0f;
+}
+
+static bool cmu_backend_acquire(CmuBackend *cmu) {
+    float luma;
+    if (R_FAILED(cmu->ops.get_luma(cmu->ops.ctx, &luma))) {
+        cmu->failed = true;
+        return false;
+    }
+    cmu->savedLuma = luma;
+    cmu->appliedAlpha = -1;
+    cmu->acquired = true;
+    return true;
+}
+
+DimBackend cmu_backend_select(CmuBackend *cmu, DimBackend requested, bool need_layer) {
+    bool useCmu = requested == DimBackend_Cmu && !need_layer && cmu->available && !cmu->failed;
+    if (useCmu && !cmu->acquired) useCmu = cmu_backend_acquire(cmu);
+    if (!useCmu) cmu_backend_release(cmu);
+    return useCmu ? DimBackend_Cmu : DimBackend_Layer;
+}
+
+bool cmu_backend_present(CmuBackend *cmu, u8 alpha) {
+    if (!cmu->acquired || cmu->appliedAlpha == (s32)alpha) return false;
+    if (R_FAILED(cmu->ops.set_luma(cmu->ops.ctx, cmu_alpha_to_luma(cmu->savedLuma, alpha)))) {
+        cmu->failed = true;
+        cmu_backend_release(cmu);
+        return false;
+    }
+    cmu->appliedAlpha = alpha;
+    return true;
+}
+
+void cmu_backend_resume(CmuBackend *cmu) {
+    cmu->appliedAlpha = -1;
+}
+
+void cmu_backend_release(CmuBackend *cmu) {
+    if (!cmu->acquired) return;
+    cmu->acquired = false;
+    // 设置失败或刚醒来时 luma 的实际值未知，总是写回一次；写回失败也无法再做什么
+    cmu->ops.set_luma(cmu->ops.ctx, cmu->savedLuma);
+    cmu->appliedAlpha = -1;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// 色彩管理（CMU）暗化后端：用显示器的 luma 偏移代替合成器混合的覆盖层，暗化时不需要任何图层
+// 接管时保存原来的 luma，交还时恢复；命令失败后不再尝试，由主循环退回图层
+// 显示服务抽象为 CmuOps：sysmodule 中是 VI（cmu_vi.c），宿主测试中是记录调用的替身
+// （与平台无关：sysmodule 和宿主工具共用）
+#include <switch/types.h>
+
+typedef enum {
+    DimBackend_Layer, // 全屏覆盖层（默认）
+    DimBackend_Cmu,   // 显示器色彩管理
+    DimBackend_Count,
+} DimBackend;
+
+// luma 偏移的范围为 -1..1，0 为系统默认；alpha 为 0-255（与 RGBA8888 的均匀暗化同一精度），255 时到达下限
+#define CMU_LUMA_MIN -1.0f
+
+typedef struct {
+    void *ctx;
+    Result (*get_luma)(void *ctx, float *out);
+    Result (*set_luma)(void *ctx, float luma);
+} CmuOps;
+
+typedef struct {
+    CmuOps ops;
+    bool available;    // 有可用的显示服务
+    bool acquired;     // 已接管 luma
+    bool failed;       // 命令失败过
+    float savedLuma;   // 接管前的 luma
+    s32 appliedAlpha;  // 最近一次设置的 alpha（0-255），-1 表示接管后尚未设置
+} CmuBackend;
+
+// ops 为 NULL 表示没有可用的显示服务
+void cmu_backend_init(CmuBackend *cmu, const CmuOps *ops);
+
+// 接管前的 luma 为 base 时 alpha（0-255）对应的 luma：在 base 和 CMU_LUMA_MIN 之间线性插值
+float cmu_alpha_to_luma(float base, u8 alpha);
+
+// 按请求的后端决定实际使用的后端，并相应地接管或交还 luma；
+// need_layer 为真（区域、掩码这类只有图层能画的配置）或 CMU 不可用时使用图层
+DimBackend cmu_backend_select(CmuBackend *cmu, DimBackend requested, bool need_layer);
+
+static inline bool cmu_backend_active(const CmuBackend *cmu) {
+    return cmu->acquired;
+}
+
+// 只在 alpha（0-255）变化时设置 luma；返回是否发出了命令。
+// 命令失败时交还 luma 并标记为失败，之后 cmu_backend_active 为假
+bool cmu_backend_present(CmuBackend *cmu, u8 alpha);
+
+// 醒来后显示器可能恢复了默认值：下一次 present 重新设置
+void cmu_backend_resume(CmuBackend *cmu);
+
+// 恢复接管前的 luma
+void cmu_backend_release(CmuBackend *cmu);
@@ -0,0 +1,28 @@
+// VI 色彩管理命令
+// libnx 没有封装 CMU 命令；它们在 ISystemDisplayService 上（Manager 权限下同样可用），
+// IManagerDisplayService 只有 SetDisplayAlpha 这类整屏命令，参数布局与 libnx 的 viSetDisplayAlpha 相同
+#include "cmu_vi.h"
+
+#define VI_CMD_GET_DISPLAY_CMU_LUMA 3216
+#define VI_CMD_SET_DISPLAY_CMU_LUMA 3217
+
+static Result cmu_vi_get_luma(void *ctx, float *out) {
+    const ViDisplay *display = ctx;
+    return serviceDispatchInOut(viGetSession_ISystemDisplayService(), VI_CMD_GET_DISPLAY_CMU_LUMA, display->display_id, *out);
+}
+
+static Result cmu_vi_set_luma(void *ctx, float luma) {
+    const ViDisplay *display = ctx;
+    const struct {
+        float luma;
+        u32 pad;
+        u64 displayId;
+    } in = { luma, 0, display->display_id };
+    return serviceDispatchIn(viGetSession_ISystemDisplayService(), VI_CMD_SET_DISPLAY_CMU_LUMA, in);
+}
+
+void cmu_vi_ops(ViDisplay *display, CmuOps *out) {
+    out->ctx = display;
+    out->get_luma = cmu_vi_get_luma;
+    out->set_luma = cmu_vi_set_luma;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// ISystemDisplayService 的 CMU luma 命令：作为 CmuOps 提供给色彩管理暗化后端（需先 viInitialize）
+#include <switch.h>
+#include "cmu.h"
+
+void cmu_vi_ops(ViDisplay *display, CmuOps *out);
@@ -0,0 +1,384 @@
+// 配置文件解析与变化检测
+// 解析：一次 ini_browse 收集所有键，优先级在内存中合并
+// 变化检测：用按路径查询的修改时间戳作为廉价的变化信号，只有真正变化时才重新解析 INI
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <dclight/ipc.h>
+#include "config.h"
+#include "util/log.h"
+#include "metrics.h"
+#include "minIni.h"
+
+// 键可出现的位置，按优先级从高到低排列
+typedef enum {
+    CONFIG_SCOPE_ROOT,
+    CONFIG_SCOPE_DCLIGHT,
+    CONFIG_SCOPE_OVERLAY,
+    CONFIG_SCOPE_COUNT,
+} ConfigScope;
+
+static const char *const g_scopeSections[CONFIG_SCOPE_COUNT] = { "", "DClight", "overlay" };
+
+// 键名 -> OverlayConfig 字段
+// names 不为 NULL 时值为名称，存入它在 names（以 NULL 结尾）中的下标；也接受数字
+// parse 不为 NULL 时由它解析值，返回 -1 表示无效
+typedef struct {
+    const char *name;
+    size_t offset;
+    const char *const *names;
+    long (*parse)(const char *value);
+} ConfigKeyDesc;
+
+static const char *const g_maskNames[DimMask_Count + 1] = { "none", "vignette", "top", "bottom", "topbottom", NULL };
+static const char *const g_backendNames[DimBackend_Count + 1] = { "layer", "cmu", NULL };
+static const char *const g_fbFormatNames[BlFormat_Count + 1] = { "rgba4444", "rgba8888", "rgb565", NULL };
+
+// 按键组合（如 ZL+ZR），存为 HidNpadButton 位掩码
+static long config_parse_buttons(const char *value) {
+    u64 mask;
+    if (!hotkey_parse_buttons(value, &mask)) {
+        log_warning("无效的按键组合: %s", value);
+        return -1;
+    }
+    return (long)mask;
+}
+
+static const ConfigKeyDesc g_configKeys[] = {
+    { "brightness", offsetof(OverlayConfig, brightness) },
+    { "alpha",      offsetof(OverlayConfig, alpha) },
+    { "config_poll_ms", offsetof(OverlayConfig, config_poll_ms) },
+    { "ramp_ms",    offsetof(OverlayConfig, ramp_ms) },
+    { "mask",       offsetof(OverlayConfig, mask), g_maskNames },
+    { "mask_width", offsetof(OverlayConfig, mask_width) },
+    { "mask_height", offsetof(OverlayConfig, mask_height) },
+    { "mask_strength", offsetof(OverlayConfig, mask_strength) },
+    { "mask_extent", offsetof(OverlayConfig, mask_extent) },
+    { "mask_light_x", offsetof(OverlayConfig, mask_light_x) },
+    { "mask_light_y", offsetof(OverlayConfig, mask_light_y) },
+    { "mask_light_w", offsetof(OverlayConfig, mask_light_w) },
+    { "mask_light_h", offsetof(OverlayConfig, mask_light_h) },
+    { "mask_light_alpha", offsetof(OverlayConfig, mask_light_alpha) },
+    { "hotkey",      offsetof(OverlayConfig, hotkey), NULL, config_parse_buttons },
+    { "hotkey_up",   offsetof(OverlayConfig, hotkey_up), NULL, config_parse_buttons },
+    { "hotkey_down", offsetof(OverlayConfig, hotkey_down), NULL, config_parse_buttons },
+    { "hotkey_step", offsetof(OverlayConfig, hotkey_step) },
+    { "hotkey_poll_ms", offsetof(OverlayConfig, hotkey_poll_ms) },
+    { "dim_backend", offsetof(OverlayConfig, dim_backend), g_backendNames },
+    { "fb_format",   offsetof(OverlayConfig, fb_format), g_fbFormatNames },
+    { "indicator_ms", offsetof(OverlayConfig, indicator_ms) },
+};
+
+#define CONFIG_KEY_COUNT (sizeof(g_configKeys) / sizeof(g_configKeys[0]))
+
+static inline long *config_field(OverlayConfig *cfg, const ConfigKeyDesc *key) {
+    return (long *)((u8 *)cfg + key->offset);
+}
+
+static void config_reset(OverlayConfig *cfg) {
+    for (size_t i = 0; i < CONFIG_KEY_COUNT; ++i) {
+        *config_field(cfg, &g_configKeys[i]) = -1;
+    }
+}
+
+typedef struct {
+    OverlayConfig scopes[CONFIG_SCOPE_COUNT];
+    ProfileTable *profiles; // 可为 NULL
+    Schedule *schedule;     // 可为 NULL
+    DimRegionList *regions; // 可为 NULL
+} ConfigBrowseState;
+
+static long config_parse_value(const ConfigKeyDesc *key, const char *value) {
+    if (key->parse) return key->parse(value);
+    if (key->names) {
+        for (long i = 0; key->names[i] != NULL; ++i) {
+            if (strcasecmp(value, key->names[i]) == 0) return i;
+        }
+    }
+    return ini_parse_getl(value, -1);
+}
+
+// 负值视为未设置
+static long config_clamp(long v, long max) {
+    if (v < 0) return -1;
+    return v > max ? max : v;
+}
+
+// [title_<id>] 节中的键；同样以第一次出现为准
+static void config_profile_key(TitleProfile *profile, const char *key, const char *value) {
+    long v = ini_parse_getl(value, -1);
+    if (strcasecmp(key, "brightness") == 0) {
+        if (profile->brightness < 0) profile->brightness = (s16)config_clamp(v, DCLIGHT_BRIGHTNESS_MAX);
+    } else if (strcasecmp(key, "alpha") == 0) {
+        if (profile->alpha < 0) profile->alpha = (s16)config_clamp(v, DCLIGHT_ALPHA_MAX);
+    } else if (strcasecmp(key, "ramp_ms") == 0) {
+        if (profile->ramp_ms < 0) profile->ramp_ms = (s32)config_limit_ramp_ms(v);
+    }
+}
+
+// [schedule] 节：interpolate=0/1，其余键为 HH:MM=亮度
+static void config_schedule_key(Schedule *schedule, const char *key, const char *value) {
+    if (strcasecmp(key, "interpolate") == 0) {
+        schedule->interpolate = ini_parse_getl(value, 0) != 0;
+        return;
+    }
+    u32 second;
+    long brightness = ini_parse_getl(value, -1);
+    if (!schedule_parse_time(key, &second) || brightness < 0) {
+        log_warning("[schedule] 无效的项: %s=%s", key, value);
+        return;
+    }
+    if (!schedule_add(schedule, second, (s32)config_clamp(brightness, DCLIGHT_BRIGHTNESS_MAX))) {
+        log_warning("[schedule] 最多 %d 个时间点，忽略 %s", SCHEDULE_MAX_POINTS, key);
+    }
+}
+
+// [regions] 节：名称=x,y,w,h[,alpha]；同名区域以第一次出现为准
+static void config_region_key(DimRegionList *list, const char *key, const char *value) {
+    for (u32 i = 0; i < list->count; ++i) {
+        if (strncmp(list->items[i].name, key, DIM_REGION_NAME_MAX - 1) == 0) return;
+    }
+    if (list->count >= DIM_REGION_MAX) {
+        log_warning("[regions] 最多 %d 个区域，忽略 %s", DIM_REGION_MAX, key);
+        return;
+    }
+    if (!dim_region_parse(key, value, &list->items[list->count])) {
+        log_warning("[regions] 无效的区域: %s=%s", key, value);
+        return;
+    }
+    list->count++;
+}
+
+static int config_browse_cb(const char *section, const char *key, const char *value, void *userdata) {
+    ConfigBrowseState *state = (ConfigBrowseState *)userdata;
+
+    int scope = -1;
+    for (int i = 0; i < CONFIG_SCOPE_COUNT; ++i) {
+        if (strcasecmp(section, g_scopeSections[i]) == 0) {
+            scope = i;
+            break;
+        }
+    }
+    if (scope < 0) {
+        u64 title_id;
+        if (state->schedule && strcasecmp(section, SCHEDULE_SECTION) == 0) {
+            config_schedule_key(state->schedule, key, value);
+        } else if (state->regions && strcasecmp(section, DIM_REGION_SECTION) == 0) {
+            config_region_key(state->regions, key, value);
+        } else if (state->profiles && profile_parse_section(section, &title_id)) {
+            TitleProfile *profile = profile_table_upsert(state->profiles, title_id);
+            if (profile) config_profile_key(profile, key, value);
+        }
+        return 1;
+    }
+
+    for (size_t i = 0; i < CONFIG_KEY_COUNT; ++i) {
+        if (strcasecmp(key, g_configKeys[i].name) != 0) continue;
+        // 与 ini_getl 一致：同一节内重复的键以第一次出现为准
+        long *field = config_field(&state->scopes[scope], &g_configKeys[i]);
+        if (*field < 0) *field = config_parse_value(&g_configKeys[i], value);
+        break;
+    }
+    return 1;
+}
+
+bool config_load(OverlayConfig *out, ProfileTable *profiles, Schedule *schedule, DimRegionList *regions) {
+    u64 start = armGetSystemTick();
+    ConfigBrowseState state;
+    for (int i = 0; i < CONFIG_SCOPE_COUNT; ++i) {
+        config_reset(&state.scopes[i]);
+    }
+    state.profiles = profiles;
+    if (profiles) profile_table_init(profiles);
+    state.schedule = schedule;
+    if (schedule) schedule_reset(schedule);
+    state.regions = regions;
+    if (regions) regions->count = 0;
+
+    bool ok = ini_browse(config_browse_cb, &state, CONFIG_INI_PATH) != 0;
+    metrics_count(MetricCount_ConfigRead);
+
+    config_reset(out);
+    for (size_t k = 0; k < CONFIG_KEY_COUNT; ++k) {
+        long *dst = config_field(out, &g_configKeys[k]);
+        for (int i = 0; i < CONFIG_SCOPE_COUNT && *dst < 0; ++i) {
+            *dst = *config_field(&state.scopes[i], &g_configKeys[k]);
+        }
+    }
+    metrics_time(MetricTime_ConfigReload, armGetSystemTick() - start);
+    return ok;
+}
+
+void config_apply_profile(OverlayConfig *cfg, const TitleProfile *profile) {
+    if (profile->brightness >= 0) {
+        cfg->brightness = profile->brightness;
+    } else if (profile->alpha >= 0) {
+        // 应用只指定了 alpha 时不能被全局的 brightness 覆盖
+        cfg->brightness = -1;
+        cfg->alpha = profile->alpha;
+    }
+    if (profile->ramp_ms >= 0) cfg->ramp_ms = profile->ramp_ms;
+}
+
+u8 config_brightness_to_alpha(long brightness) {
+    if (brightness < 0) brightness = 0;
+    return (u8)dclightBrightnessToAlpha((u32)brightness);
+}
+
+u8 config_dim_alpha(const OverlayConfig *cfg) {
+    long alpha_override = cfg->alpha;
+
+    if (cfg->brightness >= 0) {
+        return config_brightness_to_alpha(cfg->brightness);
+    }
+    if (alpha_override >= 0) {
+        if (alpha_override > 15) alpha_override = 15;
+        return (u8)alpha_override;
+    }
+    // 默认：不暗化
+    return 0;
+}
+
+u8 config_brightness_to_alpha8(long brightness) {
+    if (brightness < 0) brightness = 0;
+    return (u8)dclightBrightnessToAlpha8((u32)brightness);
+}
+
+u8 config_alpha_to_alpha8(u8 alpha) {
+    if (alpha > DCLIGHT_ALPHA_MAX) alpha = DCLIGHT_ALPHA_MAX;
+    return (u8)(alpha * 17);
+}
+
+u8 config_dim_alpha8(const OverlayConfig *cfg) {
+    if (cfg->brightness >= 0) return config_brightness_to_alpha8(cfg->brightness);
+    return config_alpha_to_alpha8(config_dim_alpha(cfg));
+}
+
+u32 config_ramp_ms(const OverlayConfig *cfg) {
+    if (cfg->ramp_ms < 0) return CONFIG_DEFAULT_RAMP_MS;
+    return (u32)config_limit_ramp_ms(cfg->ramp_ms);
+}
+
+long config_limit_ramp_ms(long ramp_ms) {
+    return config_clamp(ramp_ms, CONFIG_MAX_RAMP_MS);
+}
+
+void config_dim_mask(const OverlayConfig *cfg, DimMaskConfig *out) {
+    out->shape = cfg->mask > 0 && cfg->mask < DimMask_Count ? (DimMaskShape)cfg->mask : DimMask_None;
+    out->width = cfg->mask_width > 0 ? (u32)config_clamp(cfg->mask_width, DIM_MASK_MAX_WIDTH) : DIM_MASK_DEFAULT_WIDTH;
+    out->height = cfg->mask_height > 0 ? (u32)config_clamp(cfg->mask_height, DIM_MASK_MAX_HEIGHT) : DIM_MASK_DEFAULT_HEIGHT;
+    out->strength = cfg->mask_strength >= 0 ? (s32)config_clamp(cfg->mask_strength, DCLIGHT_ALPHA_MAX) : 6;
+    out->extent = cfg->mask_extent > 0 ? (s32)config_clamp(cfg->mask_extent, 100) : 30;
+    out->light_x = cfg->mask_light_x >= 0 ? (s32)config_clamp(cfg->mask_light_x, 100) : 0;
+    out->light_y = cfg->mask_light_y >= 0 ? (s32)config_clamp(cfg->mask_light_y, 100) : 0;
+    out->light_w = cfg->mask_light_w >= 0 ? (s32)config_clamp(cfg->mask_light_w, 100) : 0;
+    out->light_h = cfg->mask_light_h >= 0 ? (s32)config_clamp(cfg->mask_light_h, 100) : 0;
+    out->light_alpha = cfg->mask_light_alpha > 0 ? (s32)config_clamp(cfg->mask_light_alpha, DCLIGHT_ALPHA_MAX) : 0;
+}
+
+DimBackend config_dim_backend(const OverlayConfig *cfg) {
+    return cfg->dim_backend > 0 && cfg->dim_backend < DimBackend_Count ? (DimBackend)cfg->dim_backend : DimBackend_Layer;
+}
+
+BlFormat config_fb_format(const OverlayConfig *cfg) {
+    return cfg->fb_format > 0 && cfg->fb_format < BlFormat_Count ? (BlFormat)cfg->fb_format : BlFormat_RGBA4444;
+}
+
+u32 config_indicator_ms(const OverlayConfig *cfg) {
+    return cfg->indicator_ms >= 0 ? (u32)config_clamp(cfg->indicator_ms, 10000) : CONFIG_DEFAULT_INDICATOR_MS;
+}
+
+// 默认方向键为十字键上/下（HidNpadButton_Up/Down）
+void config_hotkey(const OverlayConfig *cfg, HotkeyConfig *out) {
+    out->modifiers = cfg->hotkey > 0 ? (u64)cfg->hotkey : 0;
+    out->up = cfg->hotkey_up > 0 ? (u64)cfg->hotkey_up : BIT(13);
+    out->down = cfg->hotkey_down > 0 ? (u64)cfg->hotkey_down : BIT(15);
+    out->step = cfg->hotkey_step > 0 ? (s32)config_clamp(cfg->hotkey_step, DCLIGHT_BRIGHTNESS_MAX) : HOTKEY_DEFAULT_STEP;
+    out->poll_ms = cfg->hotkey_poll_ms > 0 ? (u32)config_clamp(cfg->hotkey_poll_ms, 1000) : HOTKEY_DEFAULT_POLL_MS;
+}
+
+bool config_save_brightness(u64 title_id, long brightness) {
+    if (title_id == 0) {
+        // 与 NRO 写入的位置一致
+        return ini_putl("DClight", "brightness", brightness, CONFIG_INI_PATH) != 0;
+    }
+    char section[24];
+    snprintf(section, sizeof(section), "title_%016lx", title_id);
+    return ini_putl(section, "brightness", brightness, CONFIG_INI_PATH) != 0;
+}
+
+// FAT32 的修改时间只有 2 秒精度，同一个 2 秒内写入两次时时间戳不会变化；
+// 因此检测到变化后的一段时间内仍然视为"可能变化"，让调用者继续解析，直到时间戳稳定
+// （这也覆盖了只比较文件大小才能发现的写入，所以不必打开文件取大小）
+#define CONFIG_SETTLE_NS 3000000000ULL
+
+typedef struct {
+    bool exists;
+    bool stamp_valid;
+    u64 modified;
+} ConfigStamp;
+
+static FsFileSystem *g_sdFs = NULL;
+static ConfigStamp g_lastStamp;
+static bool g_haveStamp = false;
+static u64 g_settleUntilTick = 0;
+
+Result config_watch_init(void) {
+    g_sdFs = fsdevGetDeviceFileSystem("sdmc");
+    if (g_sdFs == NULL) {
+        log_error("config_watch_init: sdmc 未挂载");
+        return MAKERESULT(Module_Libnx, LibnxError_NotFound);
+    }
+    g_haveStamp = false;
+    g_settleUntilTick = 0;
+    return 0;
+}
+
+static void config_read_stamp(ConfigStamp *out) {
+    memset(out, 0, sizeof(*out));
+    metrics_count(MetricCount_ConfigCheck);
+
+    // 按路径查询时间戳，不打开文件：每次检查只有一次 FS 请求
+    char path[FS_MAX_PATH] = CONFIG_FS_PATH;
+    FsTimeStampRaw ts = {0};
+    if (R_SUCCEEDED(fsFsGetFileTimeStampRaw(g_sdFs, path, &ts))) {
+        out->exists = true;
+        out->stamp_valid = ts.is_valid;
+        out->modified = ts.modified;
+        return;
+    }
+    // 查询失败时区分文件不存在和不支持时间戳
+    FsDirEntryType type;
+    out->exists = R_SUCCEEDED(fsFsGetEntryType(g_sdFs, path, &type)) && type == FsDirEntryType_File;
+}
+
+bool config_watch_changed(void) {
+    // 未初始化时退化为每次都解析
+    if (g_sdFs == NULL) return true;
+
+    ConfigStamp stamp;
+    config_read_stamp(&stamp);
+
+    // 没有可用的时间戳时无法判断，保持旧行为
+    if (stamp.exists && !stamp.stamp_valid) return true;
+
+    u64 now = armGetSystemTick();
+    bool changed = !g_haveStamp
+        || stamp.exists != g_lastStamp.exists
+        || stamp.modified != g_lastStamp.modified;
+
+    if (changed) {
+        g_lastStamp = stamp;
+        g_haveStamp = true;
+        g_settleUntilTick = now + armNsToTicks(CONFIG_SETTLE_NS);
+        return true;
+    }
+
+    // 时间戳尚未稳定（可能在同一精度窗口内被再次写入）
+    return now < g_settleUntilTick;
+}
+
+bool config_watch_settling(void) {
+    return g_sdFs != NULL && armGetSystemTick() < g_settleUntilTick;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <switch.h>
+#include "profile.h"
+#include "schedule.h"
+#include "gfx/mask.h"
+#include "gfx/blocklinear.h"
+#include "regions.h"
+#include "hotkey.h"
+#include "cmu.h"
+
+// 配置文件路径（minIni 使用带 sdmc: 前缀的路径，FS 服务使用去掉前缀的路径）
+#define CONFIG_INI_PATH "sdmc:/config/DClight/config.ini"
+#define CONFIG_FS_PATH  "/config/DClight/config.ini"
+
+// 覆盖层关心的全部配置项（long 型，-1 表示未设置）
+// 新增配置项：在这里加字段，并在 config.c 的 g_configKeys 表中登记键名
+typedef struct {
+    long brightness; // 亮度 0-100，优先于 alpha
+    long alpha;      // 直接指定覆盖层 alpha 0-15
+    long config_poll_ms; // 定时检查配置文件的间隔（毫秒），未设置或 0 表示只在收到通知时检查
+    long ramp_ms;        // 亮度变化的过渡时长（毫秒），0 表示立即生效
+    long mask;           // 暗化掩码形状：none/vignette/top/bottom/topbottom（见 gfx/mask.h）
+    long mask_width;     // 掩码分辨率，由合成器放大到整屏；越大过渡越平滑，占用内存越多
+    long mask_height;
+    long mask_strength;  // 形状最强处额外增加的 alpha（0-15）
+    long mask_extent;    // 渐变/暗角覆盖的范围（屏幕百分比）
+    long mask_light_x;   // 较亮区域（如 HUD）的位置和尺寸（屏幕百分比）
+    long mask_light_y;
+    long mask_light_w;
+    long mask_light_h;
+    long mask_light_alpha; // 较亮区域减少的 alpha，未设置或 0 表示没有
+    long hotkey;         // 快捷键的修饰键组合（如 ZL+ZR），未设置或 none 表示不启用
+    long hotkey_up;      // 调亮/调暗的键，默认十字键上/下
+    long hotkey_down;
+    long hotkey_step;    // 每次调节的亮度，默认 5
+    long hotkey_poll_ms; // 修饰键未按住时的采样间隔，默认 100
+    long dim_backend;    // DimBackend：layer（默认）或 cmu
+    long fb_format;      // 暗化图层帧缓冲的像素格式：rgba4444（默认）、rgba8888
+    long indicator_ms;   // 快捷键或 IPC 改变亮度后亮度指示器显示的时长（毫秒），0 表示不显示
+} OverlayConfig;
+
+// 单次遍历 INI（一次打开文件），按 根 > [DClight] > [overlay] 的优先级合并各键
+// profiles 不为 NULL 时在同一遍中把 [title_<id>] 节收集到新建的表中（调用者负责 profile_table_free），
+// schedule、regions 不为 NULL 时同时收集 [schedule]、[regions] 节
+// 文件不存在时返回 false，out 中所有键为 -1
+bool config_load(OverlayConfig *out, ProfileTable *profiles, Schedule *schedule, DimRegionList *regions);
+
+// 用应用的配置覆盖全局配置中对应的键
+void config_apply_profile(OverlayConfig *cfg, const TitleProfile *profile);
+
+// 由配置计算覆盖层 alpha(0-15)，值越大越暗
+u8 config_dim_alpha(const OverlayConfig *cfg);
+
+// 亮度(0-100) -> 覆盖层 alpha(0-15)
+u8 config_brightness_to_alpha(long brightness);
+
+// 同上，但换算到 0-255：8 位 alpha 的帧缓冲（RGBA8888）按它画出 16 级之间的亮度
+u8 config_dim_alpha8(const OverlayConfig *cfg);
+u8 config_brightness_to_alpha8(long brightness);
+// alpha(0-15) -> 0-255，15 正好对应 255
+u8 config_alpha_to_alpha8(u8 alpha);
+
+// 未设置 ramp_ms 时的过渡时长
+#define CONFIG_DEFAULT_RAMP_MS 250
+
+// 过渡时长上限：超过 10 秒的过渡没有意义，防止误配置让覆盖层长时间按 vsync 刷新
+#define CONFIG_MAX_RAMP_MS 10000
+
+// 亮度变化的过渡时长（毫秒）
+u32 config_ramp_ms(const OverlayConfig *cfg);
+
+// 把任意来源（配置、应用配置节、信箱）的过渡时长限制到 CONFIG_MAX_RAMP_MS；负值视为未设置，返回 -1
+long config_limit_ramp_ms(long ramp_ms);
+
+// 由配置得到暗化掩码参数（分辨率限制在 DIM_MASK_MAX_WIDTH x DIM_MASK_MAX_HEIGHT 以内）
+void config_dim_mask(const OverlayConfig *cfg, DimMaskConfig *out);
+
+// 配置请求的暗化后端（未设置时为图层）
+DimBackend config_dim_backend(const OverlayConfig *cfg);
+
+// 配置请求的帧缓冲像素格式（未设置时为 RGBA4444）；rgb565 没有逐像素 alpha，由调用者拒绝
+BlFormat config_fb_format(const OverlayConfig *cfg);
+
+// 未设置 indicator_ms 时亮度指示器的显示时长
+#define CONFIG_DEFAULT_INDICATOR_MS 1500
+
+// 亮度指示器的显示时长（毫秒），0 表示不显示
+u32 config_indicator_ms(const OverlayConfig *cfg);
+
+// 由配置得到快捷键参数
+void config_hotkey(const OverlayConfig *cfg, HotkeyConfig *out);
+
+// 把亮度写入 config.ini（快捷键调节后延迟保存）：title_id 为 0 时写入 [DClight] 节，否则写入该应用的 [title_<id>] 节
+bool config_save_brightness(u64 title_id, long brightness);
+
+// 初始化配置监视：复用 fsdev 已挂载的 sdmc 文件系统，避免每次检查都重新打开
+Result config_watch_init(void);
+
+// 检查配置文件是否发生变化（按路径查询的 FS 修改时间戳，不打开文件）
+// 只做元数据查询，不读取文件内容；首次调用总是返回 true
+bool config_watch_changed(void);
+
+// 最近一次变化后时间戳是否仍可能未稳定；为 true 时调用者应在稍后再次检查
+bool config_watch_settling(void);
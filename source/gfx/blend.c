@@ -0,0 +1,92 @@
+// 整数混合（RGBA4444 / RGBA8888 / RGB565A）
+#include <string.h>
+#include "blend.h"
+
+void blend_const_init(BlendConst *bc, u16 color) {
+    u16 a = color >> 12;
+    bc->color = color;
+    bc->alpha = a;
+    bc->k_r = pixel_vec_splat(((color >> 0) & 0xF) * a);
+    bc->k_g = pixel_vec_splat(((color >> 4) & 0xF) * a);
+    bc->k_b = pixel_vec_splat(((color >> 8) & 0xF) * a);
+    bc->inv = pixel_vec_splat(15 - a);
+    bc->a = pixel_vec_splat(a);
+}
+
+// 一段像素的通用骨架：对齐前后逐像素，中间每次两个向量
+#define BLEND_SPAN_CONST(type, perVec, pixelFn, vecFn)              \
+    while (count > 0 && ((uintptr_t)dst & 15) != 0) {               \
+        *dst = pixelFn(*dst, bc->color);                            \
+        dst++;                                                      \
+        count--;                                                    \
+    }                                                               \
+    PixelVec *p = (PixelVec *)dst;                                  \
+    for (; count >= (perVec) * 2; count -= (perVec) * 2) {          \
+        p[0] = vecFn(p[0], bc);                                     \
+        p[1] = vecFn(p[1], bc);                                     \
+        p += 2;                                                     \
+    }                                                               \
+    for (; count >= (perVec); count -= (perVec)) {                  \
+        *p = vecFn(*p, bc);                                         \
+        p++;                                                        \
+    }                                                               \
+    dst = (type *)p;                                                \
+    while (count-- > 0) {                                           \
+        *dst = pixelFn(*dst, bc->color);                            \
+        dst++;                                                      \
+    }
+
+void blend_span_const(u16 *dst, u32 count, const BlendConst *bc) {
+    // 透明颜色不改变任何像素
+    if (bc->alpha == 0) return;
+    BLEND_SPAN_CONST(u16, PIXEL_VEC_COUNT, blend_pixel, blend_vec_const)
+}
+
+void blend_span(u16 *dst, const u16 *src, u32 count) {
+    for (; count >= PIXEL_VEC_COUNT; count -= PIXEL_VEC_COUNT) {
+        // src 来自任意线性图像，不保证对齐，按字节拷贝进出向量寄存器
+        PixelVec d, s;
+        memcpy(&d, dst, sizeof(d));
+        memcpy(&s, src, sizeof(s));
+        d = blend_vec(d, s);
+        memcpy(dst, &d, sizeof(d));
+        dst += PIXEL_VEC_COUNT;
+        src += PIXEL_VEC_COUNT;
+    }
+    while (count-- > 0) {
+        *dst = blend_pixel(*dst, *src++);
+        dst++;
+    }
+}
+
+void blend_const_init_8888(BlendConst8888 *bc, u32 color) {
+    u16 a = color >> 24;
+    bc->color = color;
+    bc->alpha = a;
+    bc->k_lo = pixel_vec_pair((color & 0xFF) * a, ((color >> 16) & 0xFF) * a);
+    bc->k_hi = pixel_vec_pair(((color >> 8) & 0xFF) * a, 0);
+    bc->inv = pixel_vec_splat(255 - a);
+    bc->inv_hi = pixel_vec_pair(255 - a, 0);
+    bc->a_hi = pixel_vec_pair(0, a);
+    bc->amask = pixel_vec_pair(0, 0xFFFF);
+}
+
+void blend_const_init_565a(BlendConst565A *bc, u32 color) {
+    u16 a = (color >> 16) & 0xFF;
+    bc->color = color;
+    bc->alpha = a;
+    bc->k_b = pixel_vec_splat((color & 0x1F) * a);
+    bc->k_g = pixel_vec_splat(((color >> 5) & 0x3F) * a);
+    bc->k_r = pixel_vec_splat(((color >> 11) & 0x1F) * a);
+    bc->inv = pixel_vec_splat(255 - a);
+}
+
+void blend_span_const_8888(u32 *dst, u32 count, const BlendConst8888 *bc) {
+    if (bc->alpha == 0) return;
+    BLEND_SPAN_CONST(u32, 4, blend_pixel_8888, blend_vec_const_8888)
+}
+
+void blend_span_const_565a(u16 *dst, u32 count, const BlendConst565A *bc) {
+    if (bc->alpha == 0) return;
+    BLEND_SPAN_CONST(u16, PIXEL_VEC_COUNT, blend_pixel_565a, blend_vec_const_565a)
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+// RGBA4444 像素混合（与 libtesla blendColor 的结果逐位一致，但只用整数运算）：
+//   out.rgb = (color.rgb * color.a + dst.rgb * (15 - color.a)) / 15
+//   out.a   = min(15, dst.a + color.a)
+// 0..225 范围内 n / 15 == (n * 137) >> 11，除法换成乘法和移位，8 个像素一组用 16 位向量计算
+// RGBA8888 与 RGB565A 用同样的规则，alpha 为 0-255，除以 255 换成 (n + 1 + (n >> 8)) >> 8（n < 65536 时精确）；
+// RGBA8888 的 16 字节（4 个像素）按奇偶字节拆成两个 16 位向量计算，RGB565A 的结果不透明
+#include <switch/types.h>
+#include "blocklinear.h"
+
+// 8 个 16bpp 像素（AArch64 上为 NEON q 寄存器，x86-64 上为 SSE 寄存器）
+typedef u16 PixelVec __attribute__((vector_size(16), aligned(16)));
+
+#define PIXEL_VEC_COUNT 8
+
+// 同一 16 字节按 4 个 32 位通道看待（RGBA8888 的 4 个像素）
+typedef u32 PixelVec32 __attribute__((vector_size(16), aligned(16)));
+
+static inline PixelVec pixel_vec_splat(u16 v) {
+    return (PixelVec){ v, v, v, v, v, v, v, v };
+}
+
+// 单个颜色叠加到一段像素上时预先算好的常量
+typedef struct {
+    u16 color;
+    u16 alpha;
+    PixelVec k_r, k_g, k_b; // color 各通道 * alpha
+    PixelVec inv;           // 15 - alpha
+    PixelVec a;             // alpha
+} BlendConst;
+
+void blend_const_init(BlendConst *bc, u16 color);
+
+// 单像素混合
+static inline u16 blend_pixel(u16 dst, u16 color) {
+    u32 a = color >> 12;
+    u32 inv = 15 - a;
+    u32 r = (((color >> 0) & 0xF) * a + ((dst >> 0) & 0xF) * inv) * 137 >> 11;
+    u32 g = (((color >> 4) & 0xF) * a + ((dst >> 4) & 0xF) * inv) * 137 >> 11;
+    u32 b = (((color >> 8) & 0xF) * a + ((dst >> 8) & 0xF) * inv) * 137 >> 11;
+    u32 outA = (dst >> 12) + a;
+    if (outA > 15) outA = 15;
+    return (u16)(r | (g << 4) | (b << 8) | (outA << 12));
+}
+
+// 8 个像素叠加同一颜色
+static inline PixelVec blend_vec_const(PixelVec dst, const BlendConst *bc) {
+    const PixelVec nib = pixel_vec_splat(0xF);
+    PixelVec r = ((bc->k_r + (dst & nib) * bc->inv) * 137) >> 11;
+    PixelVec g = ((bc->k_g + ((dst >> 4) & nib) * bc->inv) * 137) >> 11;
+    PixelVec b = ((bc->k_b + ((dst >> 8) & nib) * bc->inv) * 137) >> 11;
+    PixelVec a = (dst >> 12) + bc->a;
+    PixelVec over = (PixelVec)(a > nib);
+    a = (a & ~over) | (nib & over);
+    return r | (g << 4) | (b << 8) | (a << 12);
+}
+
+// 8 个像素各自叠加 src 中对应的颜色
+static inline PixelVec blend_vec(PixelVec dst, PixelVec src) {
+    const PixelVec nib = pixel_vec_splat(0xF);
+    PixelVec a = src >> 12;
+    PixelVec inv = nib - a;
+    PixelVec r = (((src & nib) * a + (dst & nib) * inv) * 137) >> 11;
+    PixelVec g = ((((src >> 4) & nib) * a + ((dst >> 4) & nib) * inv) * 137) >> 11;
+    PixelVec b = ((((src >> 8) & nib) * a + ((dst >> 8) & nib) * inv) * 137) >> 11;
+    PixelVec outA = (dst >> 12) + a;
+    PixelVec over = (PixelVec)(outA > nib);
+    outA = (outA & ~over) | (nib & over);
+    return r | (g << 4) | (b << 8) | (outA << 12);
+}
+
+// 一段连续像素叠加同一颜色（像素顺序无关，可直接用于块线性内存中的整段 GOB）
+// dst 按 16 字节对齐时走向量路径，其余像素逐个处理
+void blend_span_const(u16 *dst, u32 count, const BlendConst *bc);
+
+// ---- RGBA8888 / RGB565A ----
+
+// 通道常量按 16 位通道交替排列（RGBA8888 的低/高字节分开后，偶数通道为 R/G，奇数通道为 B/A）
+static inline PixelVec pixel_vec_pair(u16 even, u16 odd) {
+    return (PixelVec){ even, odd, even, odd, even, odd, even, odd };
+}
+
+static inline u32 blend_div255(u32 n) {
+    return (n + 1 + (n >> 8)) >> 8;
+}
+
+typedef struct {
+    u32 color;
+    u32 alpha;
+    PixelVec k_lo;   // (R, B) * alpha
+    PixelVec k_hi;   // (G * alpha, 0)
+    PixelVec inv;    // 255 - alpha
+    PixelVec inv_hi; // (255 - alpha, 0)
+    PixelVec a_hi;   // (0, alpha)
+    PixelVec amask;  // (0, 0xFFFF)
+} BlendConst8888;
+
+typedef struct {
+    u32 color;
+    u32 alpha;
+    PixelVec k_r, k_g, k_b; // 各通道（5/6/5 位）* alpha
+    PixelVec inv;           // 255 - alpha
+} BlendConst565A;
+
+void blend_const_init_8888(BlendConst8888 *bc, u32 color);
+void blend_const_init_565a(BlendConst565A *bc, u32 color);
+
+static inline u32 blend_pixel_8888(u32 dst, u32 color) {
+    u32 a = color >> 24;
+    u32 inv = 255 - a;
+    u32 r = blend_div255(((color >> 0) & 0xFF) * a + ((dst >> 0) & 0xFF) * inv);
+    u32 g = blend_div255(((color >> 8) & 0xFF) * a + ((dst >> 8) & 0xFF) * inv);
+    u32 b = blend_div255(((color >> 16) & 0xFF) * a + ((dst >> 16) & 0xFF) * inv);
+    u32 outA = (dst >> 24) + a;
+    if (outA > 255) outA = 255;
+    return r | (g << 8) | (b << 16) | (outA << 24);
+}
+
+static inline u16 blend_pixel_565a(u16 dst, u32 color) {
+    u32 a = (color >> 16) & 0xFF;
+    u32 inv = 255 - a;
+    u32 b = blend_div255(((color >> 0) & 0x1F) * a + ((dst >> 0) & 0x1F) * inv);
+    u32 g = blend_div255(((color >> 5) & 0x3F) * a + ((dst >> 5) & 0x3F) * inv);
+    u32 r = blend_div255(((color >> 11) & 0x1F) * a + ((dst >> 11) & 0x1F) * inv);
+    return (u16)(b | (g << 5) | (r << 11));
+}
+
+// 4 个 RGBA8888 像素叠加同一颜色：每个 16 位通道的低字节为 R/B、高字节为 G/A，分开后各自在 16 位里计算
+static inline PixelVec blend_vec_const_8888(PixelVec dst, const BlendConst8888 *bc) {
+    const PixelVec max = pixel_vec_splat(0xFF);
+    PixelVec lo = bc->k_lo + (dst & max) * bc->inv;
+    PixelVec hi = bc->k_hi + (dst >> 8) * bc->inv_hi;
+    lo = (lo + 1 + (lo >> 8)) >> 8;
+    hi = (hi + 1 + (hi >> 8)) >> 8;
+    PixelVec a = (dst >> 8) + bc->a_hi;
+    PixelVec over = (PixelVec)(a > max);
+    a = (a & ~over) | (max & over);
+    return lo | ((hi | (a & bc->amask)) << 8);
+}
+
+// 4 个 RGBA8888 像素各自叠加 src 中对应的颜色：先把每个像素的 alpha 复制到它的两个 16 位通道，再按奇偶字节分开计算
+static inline PixelVec blend_vec_8888(PixelVec dst, PixelVec src) {
+    const PixelVec max = pixel_vec_splat(0xFF);
+    const PixelVec odd = pixel_vec_pair(0, 0xFFFF);
+    PixelVec32 a32 = (PixelVec32)src >> 24;
+    PixelVec a = (PixelVec)(a32 | (a32 << 16));
+    PixelVec inv = max - a;
+    PixelVec lo = (src & max) * a + (dst & max) * inv;
+    PixelVec hi = (src >> 8) * a + (dst >> 8) * inv;
+    lo = (lo + 1 + (lo >> 8)) >> 8;
+    hi = (hi + 1 + (hi >> 8)) >> 8;
+    PixelVec outA = (dst >> 8) + a;
+    PixelVec over = (PixelVec)(outA > max);
+    outA = (outA & ~over) | (max & over);
+    return lo | (((hi & ~odd) | (outA & odd)) << 8);
+}
+
+// 8 个 RGB565A 像素叠加同一颜色
+static inline PixelVec blend_vec_const_565a(PixelVec dst, const BlendConst565A *bc) {
+    PixelVec b = bc->k_b + (dst & pixel_vec_splat(0x1F)) * bc->inv;
+    PixelVec g = bc->k_g + ((dst >> 5) & pixel_vec_splat(0x3F)) * bc->inv;
+    PixelVec r = bc->k_r + (dst >> 11) * bc->inv;
+    b = (b + 1 + (b >> 8)) >> 8;
+    g = (g + 1 + (g >> 8)) >> 8;
+    r = (r + 1 + (r >> 8)) >> 8;
+    return b | (g << 5) | (r << 11);
+}
+
+void blend_span_const_8888(u32 *dst, u32 count, const BlendConst8888 *bc);
+void blend_span_const_565a(u16 *dst, u32 count, const BlendConst565A *bc);
+
+// 一段连续像素逐个叠加 src 中的颜色（dst 与 src 顺序一一对应）
+void blend_span(u16 *dst, const u16 *src, u32 count);
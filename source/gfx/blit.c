@@ -0,0 +1,190 @@
+// 线性图像 -> 块线性帧缓冲的贴图
+// 源格式、目标格式和是否混合都是常量参数：bl_blit 在入口按三者选择一次特化版本
+#include <string.h>
+#include "blit.h"
+#include "blend.h"
+
+#define BL_INLINE static inline __attribute__((always_inline))
+
+// GOB 内 4 段 16 字节相对 GOB 起点的字节偏移（即 bl_offset_xb 中除 GOB 列以外的部分）
+static const u32 g_runOffsets[4] = { 0, 32, 256, 288 };
+
+// A4/A8 像素 -> 带 tint 颜色的 RGBA4444
+static inline u16 blit_tint(u16 tint, u32 alpha15) {
+    return (u16)((tint & 0x0FFF) | (alpha15 << 12));
+}
+
+// tint 的 alpha(0-15) 乘以源 alpha，结果 0-15
+static inline u32 blit_alpha_a4(u32 a4, u32 tintA) {
+    return (a4 * tintA * 137) >> 11; // / 15
+}
+
+// 8 位源 alpha 乘以 tint 的 alpha，结果与 tint 的 alpha 同一量程（0-15 或 0-255）
+static inline u32 blit_alpha_a8(u32 a8, u32 tintA) {
+    return (a8 * tintA + 127) / 255;
+}
+
+// 读取源行中第 i 个像素的 alpha，按目标格式的 alpha 位数换算（A4/A8）
+BL_INLINE u32 blit_source_alpha(BlitFormat format, const u8 *row, u32 i, BlFormat dst, u32 tintA) {
+    if (format == BlitFormat_A4) {
+        u8 packed = row[i / 2];
+        u32 a4 = (i & 1) ? (packed >> 4) : (packed & 0xF);
+        return dst == BlFormat_RGBA4444 ? blit_alpha_a4(a4, tintA) : blit_alpha_a8(a4 * 17, tintA);
+    }
+    return blit_alpha_a8(row[i], tintA);
+}
+
+// 读取源行中第 i 个像素并转换为目标格式下的颜色值
+BL_INLINE u32 blit_fetch(BlFormat dst, BlitFormat format, const u8 *row, u32 i, u32 tint) {
+    if (format == BlitFormat_RGBA4444) {
+        u16 px;
+        memcpy(&px, row + i * 2, sizeof(px));
+        if (dst == BlFormat_RGBA4444) return px;
+        return bl_format_pack(dst, (u8)((px & 0xF) * 17), (u8)(((px >> 4) & 0xF) * 17),
+                              (u8)(((px >> 8) & 0xF) * 17), (u8)((px >> 12) * 17));
+    }
+    switch (dst) {
+        case BlFormat_RGBA8888:
+            return (tint & 0x00FFFFFF) | (blit_source_alpha(format, row, i, dst, tint >> 24) << 24);
+        case BlFormat_RGB565A:
+            return (tint & 0xFFFF) | (blit_source_alpha(format, row, i, dst, (tint >> 16) & 0xFF) << 16);
+        default:
+            return blit_tint((u16)tint, blit_source_alpha(format, row, i, dst, (tint >> 12) & 0xF));
+    }
+}
+
+BL_INLINE void blit_pixel(BlFormat dst, u8 *p, u32 px, bool blend) {
+    switch (dst) {
+        case BlFormat_RGBA8888:
+            *(u32 *)p = blend ? blend_pixel_8888(*(u32 *)p, px) : px;
+            break;
+        case BlFormat_RGB565A:
+            *(u16 *)p = blend ? blend_pixel_565a(*(u16 *)p, px) : (u16)px;
+            break;
+        default:
+            *(u16 *)p = blend ? blend_pixel(*(u16 *)p, (u16)px) : (u16)px;
+            break;
+    }
+}
+
+// 处理一行；dst、format 与 blend 为常量，由调用处展开出各自的特化版本
+BL_INLINE void blit_row(BlFormat dst, u8 *rowBase, u32 x0, u32 x1, const u8 *src, u32 si,
+                        BlitFormat format, u32 tint, bool blend) {
+    const u32 bpp = bl_format_bpp(dst);
+    const u32 runPixels = BL_RUN_BYTES / bpp;
+    u32 x = x0;
+
+    // 对齐到 16 字节段之前逐像素处理
+    while (x < x1 && (x % runPixels) != 0) {
+        blit_pixel(dst, rowBase + bl_offset_xb(x * bpp), blit_fetch(dst, format, src, si++, tint), blend);
+        x++;
+    }
+
+    // 完整的 16 字节段：段地址按 GOB 内固定模式递推
+    u32 gobOffset = (x * bpp / BL_GOB_ROW_BYTES) * BL_BLOCK_BYTES;
+    u32 run = (x / runPixels) % 4;
+    for (; x + runPixels <= x1; x += runPixels) {
+        u8 *seg = rowBase + gobOffset + g_runOffsets[run];
+        if (dst == BlFormat_RGBA4444) {
+            PixelVec *p = (PixelVec *)seg;
+            PixelVec px;
+            if (format == BlitFormat_RGBA4444) {
+                memcpy(&px, src + si * 2, sizeof(px));
+            } else {
+                for (u32 i = 0; i < PIXEL_VEC_COUNT; ++i) {
+                    px[i] = (u16)blit_fetch(dst, format, src, si + i, tint);
+                }
+            }
+            *p = blend ? blend_vec(*p, px) : px;
+        } else if (dst == BlFormat_RGBA8888) {
+            // 4 个像素直接拼成一个向量（不经内存中转），整段一次写入或混合
+            PixelVec *p = (PixelVec *)seg;
+            PixelVec px = (PixelVec)(PixelVec32){
+                blit_fetch(dst, format, src, si + 0, tint), blit_fetch(dst, format, src, si + 1, tint),
+                blit_fetch(dst, format, src, si + 2, tint), blit_fetch(dst, format, src, si + 3, tint),
+            };
+            *p = blend ? blend_vec_8888(*p, px) : px;
+        } else {
+            for (u32 i = 0; i < runPixels; ++i) {
+                blit_pixel(dst, seg + i * bpp, blit_fetch(dst, format, src, si + i, tint), blend);
+            }
+        }
+        si += runPixels;
+
+        if (++run == 4) {
+            run = 0;
+            gobOffset += BL_BLOCK_BYTES;
+        }
+    }
+
+    while (x < x1) {
+        blit_pixel(dst, rowBase + bl_offset_xb(x * bpp), blit_fetch(dst, format, src, si++, tint), blend);
+        x++;
+    }
+}
+
+BL_INLINE void blit_rows(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img, s32 sx, s32 sy, s32 w, s32 h,
+                         u32 tint, BlFormat dst, BlitFormat format, bool blend) {
+    for (s32 r = 0; r < h; ++r) {
+        const u8 *src = (const u8 *)img->pixels + (size_t)(sy + r) * img->pitch;
+        u8 *rowBase = (u8 *)s->pixels + bl_offset_y(s, (u32)(dy + r));
+        blit_row(dst, rowBase, (u32)dx, (u32)(dx + w), src, (u32)sx, format, tint, blend);
+    }
+}
+
+#define BLIT_ROWS(dst, format, blend) blit_rows(s, dx, dy, img, sx, sy, w, h, tint, dst, format, blend)
+
+#define BLIT_FORMAT(dst)                                                                            \
+    switch (img->format) {                                                                          \
+        case BlitFormat_A4:                                                                         \
+            if (blend) { BLIT_ROWS(dst, BlitFormat_A4, true); } else { BLIT_ROWS(dst, BlitFormat_A4, false); } \
+            break;                                                                                  \
+        case BlitFormat_A8:                                                                         \
+            if (blend) { BLIT_ROWS(dst, BlitFormat_A8, true); } else { BLIT_ROWS(dst, BlitFormat_A8, false); } \
+            break;                                                                                  \
+        default:                                                                                    \
+            if (blend) { BLIT_ROWS(dst, BlitFormat_RGBA4444, true); } else { BLIT_ROWS(dst, BlitFormat_RGBA4444, false); } \
+            break;                                                                                  \
+    }
+
+// tint 的 alpha 是否为 0
+static inline bool blit_tint_transparent(BlFormat format, u32 tint) {
+    switch (format) {
+        case BlFormat_RGBA8888: return (tint >> 24) == 0;
+        case BlFormat_RGB565A:  return ((tint >> 16) & 0xFF) == 0;
+        default:                return ((tint >> 12) & 0xF) == 0;
+    }
+}
+
+void bl_blit(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img,
+             s32 sx, s32 sy, s32 w, s32 h, u32 tint, u32 flags) {
+    if (s->pixels == NULL || img->pixels == NULL) return;
+
+    // 裁剪到源图像
+    if (sx < 0) { dx -= sx; w += sx; sx = 0; }
+    if (sy < 0) { dy -= sy; h += sy; sy = 0; }
+    if (sx + w > (s32)img->width) w = (s32)img->width - sx;
+    if (sy + h > (s32)img->height) h = (s32)img->height - sy;
+    // 裁剪到目标表面
+    if (dx < 0) { sx -= dx; w += dx; dx = 0; }
+    if (dy < 0) { sy -= dy; h += dy; dy = 0; }
+    if (dx + w > (s32)s->width) w = (s32)s->width - dx;
+    if (dy + h > (s32)s->height) h = (s32)s->height - dy;
+    if (w <= 0 || h <= 0) return;
+
+    // A4/A8 在 tint 全透明时混合不产生任何变化
+    bool blend = (flags & BlitFlag_Blend) != 0;
+    if (blend && img->format != BlitFormat_RGBA4444 && blit_tint_transparent(s->format, tint)) return;
+
+    switch (s->format) {
+        case BlFormat_RGBA8888:
+            BLIT_FORMAT(BlFormat_RGBA8888)
+            break;
+        case BlFormat_RGB565A:
+            BLIT_FORMAT(BlFormat_RGB565A)
+            break;
+        default:
+            BLIT_FORMAT(BlFormat_RGBA4444)
+            break;
+    }
+}
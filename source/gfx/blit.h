@@ -0,0 +1,37 @@
+#pragma once
+
+// 线性图像 -> 块线性帧缓冲的贴图（图标、字形）
+// 按行处理：每行只计算一次 y 偏移，x 方向按 GOB 内 16 字节段的固定间隔递推，不逐像素计算 swizzle 偏移
+// 帧缓冲不是 RGBA4444 时源像素逐个转换为帧缓冲格式
+#include <switch/types.h>
+#include "blocklinear.h"
+
+typedef enum {
+    BlitFormat_RGBA4444, // 16bpp RGBA4444 像素
+    BlitFormat_A4,       // 4 位 alpha，每字节两个像素，低 4 位在前
+    BlitFormat_A8,       // 8 位 alpha
+} BlitFormat;
+
+typedef enum {
+    BlitFlag_None  = 0,
+    BlitFlag_Blend = BIT(0), // 按像素 alpha 叠加到帧缓冲上（否则直接覆盖）
+} BlitFlag;
+
+// 线性存储的源图像
+typedef struct {
+    const void *pixels;
+    u32 width;
+    u32 height;
+    u32 pitch;  // 每行字节数
+    BlitFormat format;
+} BlitImage;
+
+// 把 img 中 (sx, sy) 起 w x h 的区域画到 s 的 (dx, dy)，两侧都会裁剪
+// A4/A8 图像使用 tint（表面格式下的颜色值）的颜色，像素 alpha 与 tint 的 alpha 相乘；RGBA4444 图像忽略 tint
+void bl_blit(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img,
+             s32 sx, s32 sy, s32 w, s32 h, u32 tint, u32 flags);
+
+// 画整张图像
+static inline void bl_blit_image(const BlSurface *s, s32 dx, s32 dy, const BlitImage *img, u32 tint, u32 flags) {
+    bl_blit(s, dx, dy, img, 0, 0, (s32)img->width, (s32)img->height, tint, flags);
+}
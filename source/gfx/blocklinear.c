@@ -0,0 +1,230 @@
+// 块线性帧缓冲填充/混合内核
+// 恒定颜色的填充和混合都与像素顺序无关：完整覆盖的 GOB（以及纵向相邻的 GOB、整行的块）在内存中连续，
+// 直接按 16 字节向量整段处理；只有矩形边缘才按 16 字节一段或逐像素处理
+// 所有路径都以常量格式展开：bl_fill_rect / bl_blend_rect 在入口按表面格式选择一次特化版本
+#include <string.h>
+#include "blocklinear.h"
+#include "blend.h"
+
+// 不超过该面积的矩形走逐像素路径
+#define BL_SMALL_RECT_PIXELS 16
+
+#define BL_INLINE static inline __attribute__((always_inline))
+
+typedef u32 QuadVec __attribute__((vector_size(16), aligned(16)));
+
+// 对一个像素 / 一段 16 字节 / 一段连续内存执行的操作：填充或叠加同一颜色
+typedef struct {
+    u32 color;
+    PixelVec v;        // 填充用的 16 字节像素段
+    const void *blend; // 对应格式的 BlendConst*；NULL 表示填充
+} BlRectOp;
+
+BL_INLINE void bl_op_pixel(BlFormat fmt, const BlRectOp *op, u8 *p) {
+    switch (fmt) {
+        case BlFormat_RGBA8888:
+            *(u32 *)p = op->blend ? blend_pixel_8888(*(u32 *)p, op->color) : op->color;
+            break;
+        case BlFormat_RGB565A:
+            *(u16 *)p = op->blend ? blend_pixel_565a(*(u16 *)p, op->color) : (u16)op->color;
+            break;
+        default:
+            *(u16 *)p = op->blend ? blend_pixel(*(u16 *)p, (u16)op->color) : (u16)op->color;
+            break;
+    }
+}
+
+BL_INLINE void bl_op_run(BlFormat fmt, const BlRectOp *op, PixelVec *p) {
+    if (!op->blend) {
+        *p = op->v;
+        return;
+    }
+    switch (fmt) {
+        case BlFormat_RGBA8888: *p = blend_vec_const_8888(*p, op->blend); break;
+        case BlFormat_RGB565A:  *p = blend_vec_const_565a(*p, op->blend); break;
+        default:                *p = blend_vec_const(*p, op->blend); break;
+    }
+}
+
+// 一段连续内存；dst 与 bytes 都是 16 字节的整数倍
+BL_INLINE void bl_op_span(BlFormat fmt, const BlRectOp *op, u8 *dst, u32 bytes) {
+    if (op->blend) {
+        switch (fmt) {
+            case BlFormat_RGBA8888: blend_span_const_8888((u32 *)dst, bytes / 4, op->blend); break;
+            case BlFormat_RGB565A:  blend_span_const_565a((u16 *)dst, bytes / 2, op->blend); break;
+            default:                blend_span_const((u16 *)dst, bytes / 2, op->blend); break;
+        }
+        return;
+    }
+    PixelVec *p = (PixelVec *)dst;
+    PixelVec *end = (PixelVec *)(dst + bytes);
+    while (end - p >= 4) {
+        p[0] = op->v;
+        p[1] = op->v;
+        p[2] = op->v;
+        p[3] = op->v;
+        p += 4;
+    }
+    while (p < end) {
+        *p++ = op->v;
+    }
+}
+
+// 处理一行中的 [x0, x1)
+BL_INLINE void bl_op_row(BlFormat fmt, const BlRectOp *op, u8 *base, u32 yoff, u32 x0, u32 x1) {
+    const u32 bpp = bl_format_bpp(fmt);
+    const u32 runPixels = BL_RUN_BYTES / bpp;
+    u32 x = x0;
+    // 头部不足一段的部分逐像素处理
+    while (x < x1 && (x % runPixels) != 0) {
+        bl_op_pixel(fmt, op, base + yoff + bl_offset_xb(x * bpp));
+        x++;
+    }
+    // 中间完整的段：一次 16 字节读写
+    while (x + runPixels <= x1) {
+        bl_op_run(fmt, op, (PixelVec *)(base + yoff + bl_offset_xb(x * bpp)));
+        x += runPixels;
+    }
+    while (x < x1) {
+        bl_op_pixel(fmt, op, base + yoff + bl_offset_xb(x * bpp));
+        x++;
+    }
+}
+
+// 按块线性布局遍历矩形；由 bl_fill_rect / bl_blend_rect 以常量 fmt 和 op 展开
+BL_INLINE void bl_rect_apply(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, BlFormat fmt, const BlRectOp *op) {
+    if (s->pixels == NULL || w <= 0 || h <= 0) return;
+
+    s64 x0 = x, y0 = y, x1 = (s64)x + w, y1 = (s64)y + h;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > s->width) x1 = s->width;
+    if (y1 > s->height) y1 = s->height;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    u8 *base = (u8 *)s->pixels;
+    const u32 bpp = bl_format_bpp(fmt);
+    const u32 gobWidth = BL_GOB_ROW_BYTES / bpp;
+
+    // 很小的矩形（如 1x1 帧缓冲）直接逐像素写，比扩展到整个 GOB 更快
+    if ((x1 - x0) * (y1 - y0) <= BL_SMALL_RECT_PIXELS) {
+        for (u32 yi = (u32)y0; yi < (u32)y1; ++yi) {
+            u32 yoff = bl_offset_y(s, yi);
+            for (u32 xi = (u32)x0; xi < (u32)x1; ++xi) {
+                bl_op_pixel(fmt, op, base + yoff + bl_offset_xb(xi * bpp));
+            }
+        }
+        return;
+    }
+
+    // 到达表面边缘时扩展到 GOB 边界：填充区不可见，扩展后边缘的 GOB 也能整段写入
+    u32 paddedWidth = s->stride / bpp;
+    if (x1 == s->width) x1 = paddedWidth;
+    if (y1 == s->height) y1 = (y1 + BL_GOB_HEIGHT - 1) & ~(s64)(BL_GOB_HEIGHT - 1);
+
+    bool fullWidth = x0 == 0 && (u32)x1 == paddedWidth;
+
+    // x 方向上完整覆盖的 GOB 列 [gx0, gx1)
+    u32 gx0 = ((u32)x0 + gobWidth - 1) / gobWidth;
+    u32 gx1 = (u32)x1 / gobWidth;
+    if (gx1 < gx0) gx1 = gx0;
+    u32 xa = gx0 * gobWidth; // 完整 GOB 列覆盖的像素范围
+    u32 xb = gx1 * gobWidth;
+
+    for (u32 by = (u32)y0 / BL_BLOCK_HEIGHT * BL_BLOCK_HEIGHT; by < (u32)y1; by += BL_BLOCK_HEIGHT) {
+        u32 ya = (u32)y0 > by ? (u32)y0 : by;
+        u32 yb = (u32)y1 < by + BL_BLOCK_HEIGHT ? (u32)y1 : by + BL_BLOCK_HEIGHT;
+        u8 *blockRow = base + (by / BL_BLOCK_HEIGHT) * (s->stride * BL_BLOCK_HEIGHT);
+
+        // 整行块全部覆盖：整个块行在内存中连续
+        if (fullWidth && ya == by && yb == by + BL_BLOCK_HEIGHT) {
+            bl_op_span(fmt, op, blockRow, s->stride * BL_BLOCK_HEIGHT);
+            continue;
+        }
+
+        // 纵向完整覆盖的 GOB 行 [ga, gb)（相对块内）
+        u32 ga = (ya - by + BL_GOB_HEIGHT - 1) / BL_GOB_HEIGHT;
+        u32 gb = (yb - by) / BL_GOB_HEIGHT;
+        if (gb < ga) gb = ga;
+
+        // 完整 GOB：同一列中纵向相邻的 GOB 连续存放
+        if (gb > ga) {
+            for (u32 gx = gx0; gx < gx1; ++gx) {
+                bl_op_span(fmt, op, blockRow + gx * BL_BLOCK_BYTES + ga * BL_GOB_BYTES, (gb - ga) * BL_GOB_BYTES);
+            }
+        }
+
+        for (u32 yi = ya; yi < yb; ++yi) {
+            u32 g = (yi - by) / BL_GOB_HEIGHT;
+            u32 yoff = bl_offset_y(s, yi);
+            if (g >= ga && g < gb && gx1 > gx0) {
+                // 只剩左右两侧不足一个 GOB 的部分
+                bl_op_row(fmt, op, base, yoff, (u32)x0, xa);
+                bl_op_row(fmt, op, base, yoff, xb, (u32)x1);
+            } else {
+                bl_op_row(fmt, op, base, yoff, (u32)x0, (u32)x1);
+            }
+        }
+    }
+}
+
+void bl_fill_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color) {
+    switch (s->format) {
+        case BlFormat_RGBA8888: {
+            const BlRectOp op = { .color = color, .v = (PixelVec)(QuadVec){ color, color, color, color } };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGBA8888, &op);
+            break;
+        }
+        case BlFormat_RGB565A: {
+            const BlRectOp op = { .color = color, .v = pixel_vec_splat((u16)color) };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGB565A, &op);
+            break;
+        }
+        default: {
+            const BlRectOp op = { .color = color, .v = pixel_vec_splat((u16)color) };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGBA4444, &op);
+            break;
+        }
+    }
+}
+
+void bl_blend_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color) {
+    // alpha 为 0 时不改变像素；为最大值时结果就是 color，按填充处理（RGB565A 写入时丢弃 alpha）
+    switch (s->format) {
+        case BlFormat_RGBA8888: {
+            u32 alpha = color >> 24;
+            if (alpha == 0) return;
+            if (alpha == 0xFF) break;
+            BlendConst8888 bc;
+            blend_const_init_8888(&bc, color);
+            const BlRectOp op = { .color = color, .blend = &bc };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGBA8888, &op);
+            return;
+        }
+        case BlFormat_RGB565A: {
+            u32 alpha = (color >> 16) & 0xFF;
+            if (alpha == 0) return;
+            if (alpha == 0xFF) break;
+            BlendConst565A bc;
+            blend_const_init_565a(&bc, color);
+            const BlRectOp op = { .color = color, .blend = &bc };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGB565A, &op);
+            return;
+        }
+        default: {
+            u32 alpha = (color >> 12) & 0xF;
+            if (alpha == 0) return;
+            if (alpha == 0xF) break;
+            BlendConst bc;
+            blend_const_init(&bc, (u16)color);
+            const BlRectOp op = { .color = color, .blend = &bc };
+            bl_rect_apply(s, x, y, w, h, BlFormat_RGBA4444, &op);
+            return;
+        }
+    }
+    bl_fill_rect(s, x, y, w, h, color);
+}
+
+void bl_fill(const BlSurface *s, u32 color) {
+    bl_fill_rect(s, 0, 0, (s32)s->width, (s32)s->height, color);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+// 块线性（block-linear）帧缓冲的寻址与填充内核，布局与 libtesla getPixelOffset 一致：
+//   GOB：64 字节 x 8 行（16bpp 下为 32x8 像素，32bpp 下为 16x8 像素，512 字节连续存放）
+//   GOB 内：每 16 字节为同一行连续的一段像素（16bpp 8 个，32bpp 4 个）
+//   块：16 个 GOB 纵向连续（128 行，8192 字节），块在行方向上依次排列
+// 偏移可分解为 x 与 y 两部分之和，逐像素寻址不需要除法
+// 像素格式在每次调用时确定一次，内核按格式展开出各自的特化版本，内层循环中没有格式分支
+#include <switch/types.h>
+
+#define BL_GOB_BYTES        512
+#define BL_GOB_WIDTH        32   // 像素（16bpp）
+#define BL_GOB_HEIGHT       8
+#define BL_BLOCK_HEIGHT     128  // 16 个 GOB
+#define BL_BLOCK_GOBS       (BL_BLOCK_HEIGHT / BL_GOB_HEIGHT)
+#define BL_BLOCK_BYTES      (BL_GOB_BYTES * BL_BLOCK_GOBS)
+#define BL_RUN_PIXELS       8    // GOB 内连续存放的一段像素（16bpp）
+#define BL_RUN_BYTES        16
+#define BL_GOB_ROW_BYTES    64
+
+// 帧缓冲像素格式；内核使用的"颜色"是该格式下的像素值（见 bl_format_pack）
+typedef enum {
+    BlFormat_RGBA4444, // 16bpp，r 在低 4 位，16 级 alpha
+    BlFormat_RGBA8888, // 32bpp，r 在最低字节，256 级 alpha
+    BlFormat_RGB565A,  // 16bpp RGB565（b 在低 5 位），不存 alpha：混合时 alpha 随颜色值的 16-23 位传入，结果不透明
+    BlFormat_Count,
+} BlFormat;
+
+static inline u32 bl_format_bpp(BlFormat format) {
+    return format == BlFormat_RGBA8888 ? 4 : 2;
+}
+
+// 8 位通道颜色 -> format 下的颜色值（RGB565A 的 alpha 放在 16-23 位，写入像素时丢弃）
+static inline u32 bl_format_pack(BlFormat format, u8 r, u8 g, u8 b, u8 a) {
+    switch (format) {
+        case BlFormat_RGBA8888:
+            return (u32)r | ((u32)g << 8) | ((u32)b << 16) | ((u32)a << 24);
+        case BlFormat_RGB565A:
+            return (u32)(b >> 3) | ((u32)(g >> 2) << 5) | ((u32)(r >> 3) << 11) | ((u32)a << 16);
+        default:
+            return (u32)(r >> 4) | ((u32)(g >> 4) << 4) | ((u32)(b >> 4) << 8) | ((u32)(a >> 4) << 12);
+    }
+}
+
+// 一个块线性表面
+typedef struct {
+    void *pixels;
+    u32 width;
+    u32 height;
+    u32 stride;  // 每行字节数（framebufferCreate 计算的 stride，按 64 字节对齐）
+    BlFormat format;
+} BlSurface;
+
+// 行内第 xb 个字节对应的字节偏移
+static inline u32 bl_offset_xb(u32 xb) {
+    return (xb / BL_GOB_ROW_BYTES) * BL_BLOCK_BYTES
+         + ((xb % 64) / 32) * 256
+         + ((xb % 32) / 16) * 32
+         + (xb % 16);
+}
+
+// 16bpp 表面中 x 对应的字节偏移
+static inline u32 bl_offset_x(u32 x) {
+    return bl_offset_xb(x * 2);
+}
+
+// y 对应的字节偏移
+static inline u32 bl_offset_y(const BlSurface *s, u32 y) {
+    return (y / BL_BLOCK_HEIGHT) * (s->stride * BL_BLOCK_HEIGHT)
+         + ((y % BL_BLOCK_HEIGHT) / 8) * BL_GOB_BYTES
+         + ((y % 8) / 2) * 64
+         + (y % 2) * 16;
+}
+
+// (x, y) 在 pixels 中的下标（以像素为单位：16bpp 为 u16，32bpp 为 u32）
+static inline u32 bl_pixel_index(const BlSurface *s, u32 x, u32 y) {
+    u32 bpp = bl_format_bpp(s->format);
+    return (bl_offset_xb(x * bpp) + bl_offset_y(s, y)) / bpp;
+}
+
+// 用 color（表面格式下的颜色值）填充矩形（自动裁剪到表面范围）
+// 覆盖到表面右边缘或下边缘时，会顺带写入同一 GOB 内的对齐填充区（不可见）以便使用整段写入
+void bl_fill_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color);
+
+// 整个表面填充为 color
+void bl_fill(const BlSurface *s, u32 color);
+
+// 把 color 按其 alpha 叠加到矩形上（混合规则见 blend.h），裁剪规则同 bl_fill_rect
+void bl_blend_rect(const BlSurface *s, s32 x, s32 y, s32 w, s32 h, u32 color);
@@ -0,0 +1,105 @@
+// 内置 5x7 点阵字体
+#include "font.h"
+
+#define FONT_FIRST ' '
+#define FONT_LAST  '~'
+
+static const u8 g_font[FONT_LAST - FONT_FIRST + 1][FONT_GLYPH_HEIGHT] = {
+    ['%' - FONT_FIRST] = { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 },
+    ['-' - FONT_FIRST] = { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 },
+    ['/' - FONT_FIRST] = { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 },
+    ['0' - FONT_FIRST] = { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E },
+    ['1' - FONT_FIRST] = { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    ['2' - FONT_FIRST] = { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F },
+    ['3' - FONT_FIRST] = { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },
+    ['4' - FONT_FIRST] = { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 },
+    ['5' - FONT_FIRST] = { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },
+    ['6' - FONT_FIRST] = { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E },
+    ['7' - FONT_FIRST] = { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },
+    ['8' - FONT_FIRST] = { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E },
+    ['9' - FONT_FIRST] = { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },
+    [':' - FONT_FIRST] = { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 },
+    ['A' - FONT_FIRST] = { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },
+    ['B' - FONT_FIRST] = { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E },
+    ['C' - FONT_FIRST] = { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E },
+    ['D' - FONT_FIRST] = { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C },
+    ['E' - FONT_FIRST] = { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F },
+    ['F' - FONT_FIRST] = { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 },
+    ['G' - FONT_FIRST] = { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F },
+    ['H' - FONT_FIRST] = { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },
+    ['I' - FONT_FIRST] = { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    ['J' - FONT_FIRST] = { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C },
+    ['K' - FONT_FIRST] = { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 },
+    ['L' - FONT_FIRST] = { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F },
+    ['M' - FONT_FIRST] = { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 },
+    ['N' - FONT_FIRST] = { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 },
+    ['O' - FONT_FIRST] = { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },
+    ['P' - FONT_FIRST] = { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 },
+    ['Q' - FONT_FIRST] = { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D },
+    ['R' - FONT_FIRST] = { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 },
+    ['S' - FONT_FIRST] = { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E },
+    ['T' - FONT_FIRST] = { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },
+    ['U' - FONT_FIRST] = { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },
+    ['V' - FONT_FIRST] = { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 },
+    ['W' - FONT_FIRST] = { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A },
+    ['X' - FONT_FIRST] = { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 },
+    ['Y' - FONT_FIRST] = { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 },
+    ['Z' - FONT_FIRST] = { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F },
+    ['a' - FONT_FIRST] = { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F },
+    ['b' - FONT_FIRST] = { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E },
+    ['c' - FONT_FIRST] = { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E },
+    ['d' - FONT_FIRST] = { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F },
+    ['e' - FONT_FIRST] = { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E },
+    ['f' - FONT_FIRST] = { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 },
+    ['g' - FONT_FIRST] = { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E },
+    ['h' - FONT_FIRST] = { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 },
+    ['i' - FONT_FIRST] = { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E },
+    ['j' - FONT_FIRST] = { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C },
+    ['k' - FONT_FIRST] = { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 },
+    ['l' - FONT_FIRST] = { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },
+    ['m' - FONT_FIRST] = { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 },
+    ['n' - FONT_FIRST] = { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 },
+    ['o' - FONT_FIRST] = { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E },
+    ['p' - FONT_FIRST] = { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 },
+    ['q' - FONT_FIRST] = { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 },
+    ['r' - FONT_FIRST] = { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 },
+    ['s' - FONT_FIRST] = { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E },
+    ['t' - FONT_FIRST] = { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 },
+    ['u' - FONT_FIRST] = { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D },
+    ['v' - FONT_FIRST] = { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 },
+    ['w' - FONT_FIRST] = { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A },
+    ['x' - FONT_FIRST] = { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 },
+    ['y' - FONT_FIRST] = { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E },
+    ['z' - FONT_FIRST] = { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F },
+};
+
+const u8 *font_glyph(char c) {
+    if (c < FONT_FIRST || c > FONT_LAST) return NULL;
+    return g_font[c - FONT_FIRST];
+}
+
+void font_draw_glyph(const BlSurface *s, s32 x, s32 y, char c, u32 scale, u32 color) {
+    const u8 *glyph = font_glyph(c);
+    if (glyph == NULL) return;
+    for (s32 row = 0; row < FONT_GLYPH_HEIGHT; ++row) {
+        u8 bits = glyph[row];
+        s32 col = 0;
+        while (col < FONT_GLYPH_WIDTH) {
+            if (!(bits & (0x10 >> col))) {
+                ++col;
+                continue;
+            }
+            s32 start = col;
+            while (col < FONT_GLYPH_WIDTH && (bits & (0x10 >> col))) ++col;
+            bl_fill_rect(s, x + start * (s32)scale, y + row * (s32)scale, (col - start) * (s32)scale, (s32)scale, color);
+        }
+    }
+}
+
+s32 font_draw_text(const BlSurface *s, s32 x, s32 y, const char *text, u32 scale, u32 color) {
+    for (; *text; ++text) {
+        font_draw_glyph(s, x, y, *text, scale, color);
+        x += FONT_ADVANCE * (s32)scale;
+    }
+    return x;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// 内置点阵字体：5x7 字形在编译时烘焙成常量表（每个字形 7 字节），不读字体文件、不做光栅化
+// 绘制时按 scale 放大，每行连续的点合并成一个矩形填充
+// 字形覆盖数字、大小写字母和少量符号，表中没有的字符画成空白
+#include <switch/types.h>
+#include "blocklinear.h"
+
+#define FONT_GLYPH_WIDTH  5
+#define FONT_GLYPH_HEIGHT 7
+#define FONT_ADVANCE      6 // 字宽加 1 列间隔
+
+// 字符 c 的字形：每行一个字节，低 5 位从高到低对应从左到右；不可打印的字符返回 NULL
+const u8 *font_glyph(char c);
+
+// scale 倍放大后一段文字的宽度（不含最后一个字符后的间隔）
+static inline s32 font_text_width(u32 length, u32 scale) {
+    return length == 0 ? 0 : (s32)((length * FONT_ADVANCE - 1) * scale);
+}
+
+// 把字符 c 画到 s 的 (x, y)：字形的点填 color，其余不动
+void font_draw_glyph(const BlSurface *s, s32 x, s32 y, char c, u32 scale, u32 color);
+
+// 从 (x, y) 起画一段文字，返回画完后的 x
+s32 font_draw_text(const BlSurface *s, s32 x, s32 y, const char *text, u32 scale, u32 color);
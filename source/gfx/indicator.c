@@ -0,0 +1,91 @@
+// 亮度指示器
+#include <stdio.h>
+#include "indicator.h"
+#include "font.h"
+#include "render.h"
+
+#define INDICATOR_PAD     12
+#define INDICATOR_DIGITS  3
+#define INDICATOR_TEXT_H  (FONT_GLYPH_HEIGHT * INDICATOR_SCALE)
+#define INDICATOR_BAR_X   INDICATOR_PAD
+#define INDICATOR_BAR_Y   (INDICATOR_PAD + INDICATOR_TEXT_H + 9)
+#define INDICATOR_BAR_W   (INDICATOR_WIDTH - 2 * INDICATOR_PAD)
+#define INDICATOR_BAR_H   12
+// 数字右对齐，每个字符一格
+#define INDICATOR_CELL_W  (FONT_ADVANCE * INDICATOR_SCALE)
+#define INDICATOR_VALUE_X (INDICATOR_WIDTH - INDICATOR_PAD - font_text_width(INDICATOR_DIGITS, INDICATOR_SCALE))
+
+_Static_assert(INDICATOR_BAR_Y + INDICATOR_BAR_H + INDICATOR_PAD == INDICATOR_HEIGHT, "指示器高度与布局不一致");
+
+static const Color g_background = { 0x1, 0x1, 0x1, 0xD };
+static const Color g_text = { 0xF, 0xF, 0xF, 0xF };
+static const Color g_track = { 0x4, 0x4, 0x4, 0xF };
+static const Color g_fill = { 0xF, 0xF, 0xF, 0xF };
+
+static void damage_add(IndicatorDamage *d, s32 x, s32 y, s32 w, s32 h) {
+    if (w <= 0 || h <= 0) return;
+    d->pixels += (u32)(w * h);
+    IndicatorRect *r = &d->bounds;
+    if (r->w == 0) {
+        *r = (IndicatorRect){ x, y, w, h };
+        return;
+    }
+    s32 x1 = r->x + r->w > x + w ? r->x + r->w : x + w;
+    s32 y1 = r->y + r->h > y + h ? r->y + r->h : y + h;
+    r->x = r->x < x ? r->x : x;
+    r->y = r->y < y ? r->y : y;
+    r->w = x1 - r->x;
+    r->h = y1 - r->y;
+}
+
+static s32 bar_length(s32 value) {
+    return value * INDICATOR_BAR_W / 100;
+}
+
+static void format_value(s32 value, char out[INDICATOR_DIGITS + 1]) {
+    snprintf(out, INDICATOR_DIGITS + 1, "%*d", INDICATOR_DIGITS, (int)value);
+}
+
+IndicatorDamage indicator_draw(IndicatorView *view, const BlSurface *s, s32 value) {
+    IndicatorDamage dirty = { { 0, 0, 0, 0 }, 0 };
+    if (value < 0) value = 0;
+    if (value > 100) value = 100;
+    if (!indicator_dirty(view, value)) return dirty;
+
+    u32 background = color_pack(s->format, g_background);
+    u32 text = color_pack(s->format, g_text);
+    char digits[INDICATOR_DIGITS + 1];
+    format_value(value, digits);
+
+    if (!view->drawn) {
+        bl_fill_rect(s, 0, 0, INDICATOR_WIDTH, INDICATOR_HEIGHT, background);
+        font_draw_text(s, INDICATOR_PAD, INDICATOR_PAD, "Brightness", INDICATOR_SCALE, text);
+        font_draw_text(s, INDICATOR_VALUE_X, INDICATOR_PAD, digits, INDICATOR_SCALE, text);
+        s32 fill = bar_length(value);
+        bl_fill_rect(s, INDICATOR_BAR_X, INDICATOR_BAR_Y, fill, INDICATOR_BAR_H, color_pack(s->format, g_fill));
+        bl_fill_rect(s, INDICATOR_BAR_X + fill, INDICATOR_BAR_Y, INDICATOR_BAR_W - fill, INDICATOR_BAR_H,
+                     color_pack(s->format, g_track));
+        damage_add(&dirty, 0, 0, INDICATOR_WIDTH, INDICATOR_HEIGHT);
+    } else {
+        // 只重画变化的数字格
+        char old[INDICATOR_DIGITS + 1];
+        format_value(view->value, old);
+        for (s32 i = 0; i < INDICATOR_DIGITS; ++i) {
+            if (old[i] == digits[i]) continue;
+            s32 x = INDICATOR_VALUE_X + i * INDICATOR_CELL_W;
+            s32 w = FONT_GLYPH_WIDTH * INDICATOR_SCALE;
+            bl_fill_rect(s, x, INDICATOR_PAD, w, INDICATOR_TEXT_H, background);
+            font_draw_glyph(s, x, INDICATOR_PAD, digits[i], INDICATOR_SCALE, text);
+            damage_add(&dirty, x, INDICATOR_PAD, w, INDICATOR_TEXT_H);
+        }
+        // 进度条只改动增减的一段
+        s32 from = bar_length(view->value), to = bar_length(value);
+        s32 x = INDICATOR_BAR_X + (from < to ? from : to);
+        s32 w = from < to ? to - from : from - to;
+        bl_fill_rect(s, x, INDICATOR_BAR_Y, w, INDICATOR_BAR_H, color_pack(s->format, from < to ? g_fill : g_track));
+        damage_add(&dirty, x, INDICATOR_BAR_Y, w, INDICATOR_BAR_H);
+    }
+    view->drawn = true;
+    view->value = value;
+    return dirty;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// 亮度指示器：“Brightness 65”加一条进度条，画在一块 INDICATOR_WIDTH x INDICATOR_HEIGHT 的表面上
+// 记住上一次画出的值，之后只重画变化的数字格和进度条增减的那一段；表面的内容必须保留到下一次绘制
+// （与平台无关：sysmodule 和宿主工具共用）
+#include <switch/types.h>
+#include "blocklinear.h"
+
+#define INDICATOR_SCALE  3 // 字形放大倍数
+#define INDICATOR_WIDTH  272
+#define INDICATOR_HEIGHT 66
+
+typedef struct {
+    s32 x, y, w, h;
+} IndicatorRect;
+
+// 一次绘制改动的范围
+typedef struct {
+    IndicatorRect bounds; // 包含所有改动的矩形，w 为 0 表示没有改动
+    u32 pixels;           // 实际重画的像素数（各段之和，小于 bounds 的面积）
+} IndicatorDamage;
+
+// 表面上已经画出的内容
+typedef struct {
+    bool drawn; // 为假时下一次整块重画
+    s32 value;
+} IndicatorView;
+
+static inline void indicator_invalidate(IndicatorView *view) {
+    view->drawn = false;
+}
+
+// 画 value（0-100）是否需要改动表面
+static inline bool indicator_dirty(const IndicatorView *view, s32 value) {
+    return !view->drawn || view->value != value;
+}
+
+// 把 value 画到 s 的左上角，返回重画的范围
+IndicatorDamage indicator_draw(IndicatorView *view, const BlSurface *s, s32 value);
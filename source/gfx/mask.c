@@ -0,0 +1,109 @@
+// 非均匀暗化掩码
+// 坐标取像素中心并归一化到 [0, 1024]，形状权重也以 1024 为 1，全部用整数计算
+#include <stdlib.h>
+#include <string.h>
+#include "mask.h"
+#include "render.h"
+
+#define MASK_ONE 1024
+
+static inline s32 clamp_s32(s32 v, s32 lo, s32 hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// 像素中心的归一化坐标（0 为左/上边缘，MASK_ONE 为右/下边缘）
+static inline s32 mask_norm(u32 i, u32 size) {
+    return (s32)(((2 * i + 1) * MASK_ONE) / (2 * size));
+}
+
+// 距离边缘 extent 以内线性增强；edge 为到最近边缘的归一化距离
+static inline s32 edge_weight(s32 edge, s32 extent) {
+    return clamp_s32(((extent - edge) * MASK_ONE) / extent, 0, MASK_ONE);
+}
+
+static s32 shape_weight(const DimMaskConfig *cfg, s32 extent, s32 nx, s32 ny) {
+    switch (cfg->shape) {
+        case DimMask_Vignette: {
+            // 以中心为原点、边缘中点为 1 的平方距离；extent 为暗角从边缘向内延伸的比例
+            s32 dx = 2 * nx - MASK_ONE, dy = 2 * ny - MASK_ONE;
+            s32 d2 = (dx * dx + dy * dy) / MASK_ONE;
+            s32 r0 = MASK_ONE - extent;
+            s32 r02 = (r0 * r0) / MASK_ONE;
+            if (r02 >= MASK_ONE) return 0;
+            return clamp_s32(((d2 - r02) * MASK_ONE) / (MASK_ONE - r02), 0, MASK_ONE);
+        }
+        case DimMask_Top:
+            return edge_weight(ny, extent);
+        case DimMask_Bottom:
+            return edge_weight(MASK_ONE - ny, extent);
+        case DimMask_TopBottom: {
+            s32 top = edge_weight(ny, extent), bottom = edge_weight(MASK_ONE - ny, extent);
+            return top > bottom ? top : bottom;
+        }
+        default:
+            return 0;
+    }
+}
+
+static bool in_light(const DimMaskConfig *cfg, s32 nx, s32 ny) {
+    if (cfg->light_alpha <= 0) return false;
+    s32 x0 = cfg->light_x * MASK_ONE / 100, y0 = cfg->light_y * MASK_ONE / 100;
+    s32 x1 = (cfg->light_x + cfg->light_w) * MASK_ONE / 100, y1 = (cfg->light_y + cfg->light_h) * MASK_ONE / 100;
+    return nx >= x0 && nx < x1 && ny >= y0 && ny < y1;
+}
+
+bool dim_mask_build(DimMask *mask, const DimMaskConfig *cfg) {
+    memset(mask, 0, sizeof(*mask));
+    u32 w = cfg->width, h = cfg->height;
+    size_t count = (size_t)w * h;
+    mask->delta = malloc(count);
+    mask->image = malloc(count * sizeof(u16));
+    if (mask->delta == NULL || mask->image == NULL) {
+        dim_mask_free(mask);
+        return false;
+    }
+    mask->config = *cfg;
+    mask->imageAlpha = 0xFF;
+
+    s32 extent = clamp_s32(cfg->extent, 1, 100) * MASK_ONE / 100;
+    s32 strength = clamp_s32(cfg->strength, 0, 15);
+    s32 light = clamp_s32(cfg->light_alpha, 0, 15);
+    for (u32 y = 0; y < h; ++y) {
+        s32 ny = mask_norm(y, h);
+        for (u32 x = 0; x < w; ++x) {
+            s32 nx = mask_norm(x, w);
+            s32 d = (shape_weight(cfg, extent, nx, ny) * strength + MASK_ONE / 2) / MASK_ONE;
+            if (in_light(cfg, nx, ny)) d -= light;
+            mask->delta[(size_t)y * w + x] = (s8)d;
+        }
+    }
+    return true;
+}
+
+void dim_mask_free(DimMask *mask) {
+    free(mask->delta);
+    free(mask->image);
+    mask->delta = NULL;
+    mask->image = NULL;
+}
+
+void dim_mask_draw(DimMask *mask, u8 alpha) {
+    if (mask->delta == NULL) return;
+    u32 w = mask->config.width, h = mask->config.height;
+
+    if (mask->imageAlpha != alpha) {
+        // 增量范围为 -15..15：查表得到各增量对应的黑色像素
+        u16 lut[31];
+        for (s32 d = -15; d <= 15; ++d) {
+            lut[d + 15] = (u16)(clamp_s32((s32)alpha + d, 0, 15) << 12);
+        }
+        size_t count = (size_t)w * h;
+        for (size_t i = 0; i < count; ++i) {
+            mask->image[i] = lut[mask->delta[i] + 15];
+        }
+        mask->imageAlpha = alpha;
+    }
+
+    BlitImage image = { mask->image, w, h, w * sizeof(u16), BlitFormat_RGBA4444 };
+    drawImage(0, 0, &image, (Color){ 0, 0, 0, 0 }, false);
+}
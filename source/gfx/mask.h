@@ -0,0 +1,50 @@
+#pragma once
+
+// 非均匀暗化掩码：在很小的帧缓冲（如 64x36）上画出暗角、上下渐变或较亮的 HUD 区域，
+// 由合成器按 ViScalingMode_FitToLayer 放大到整屏，放大本身不花费任何绘制时间
+// 形状只在配置变化时计算一次（每像素相对于基准 alpha 的增量），之后每帧只做查表和一次贴图
+#include <switch/types.h>
+
+typedef enum {
+    DimMask_None,      // 均匀暗化（1x1 帧缓冲）
+    DimMask_Vignette,  // 四周更暗
+    DimMask_Top,       // 顶部更暗
+    DimMask_Bottom,    // 底部更暗
+    DimMask_TopBottom, // 上下两端更暗
+    DimMask_Count,
+} DimMaskShape;
+
+#define DIM_MASK_DEFAULT_WIDTH  64
+#define DIM_MASK_DEFAULT_HEIGHT 36
+#define DIM_MASK_MAX_WIDTH      128
+#define DIM_MASK_MAX_HEIGHT     72
+
+typedef struct {
+    DimMaskShape shape;
+    u32 width;       // 掩码分辨率
+    u32 height;
+    s32 strength;    // 形状最强处在基准 alpha 上额外增加的 alpha（0-15）
+    s32 extent;      // 渐变/暗角覆盖的范围，占屏幕的百分比（1-100）
+    // 较亮的矩形区域（如 HUD），坐标和尺寸为屏幕的百分比；light_alpha 为 0 表示没有
+    s32 light_x, light_y, light_w, light_h;
+    s32 light_alpha; // 区域内从 alpha 中减去的值
+} DimMaskConfig;
+
+typedef struct {
+    DimMaskConfig config;
+    s8 *delta;    // width * height 个 alpha 增量
+    u16 *image;   // 线性 RGBA4444，每次绘制时由 delta 和基准 alpha 生成
+    u8 imageAlpha; // image 当前对应的基准 alpha（0xFF 表示尚未生成）
+} DimMask;
+
+// 掩码是否需要非 1x1 的帧缓冲
+static inline bool dim_mask_active(const DimMaskConfig *cfg) {
+    return cfg->shape != DimMask_None || cfg->light_alpha > 0;
+}
+
+// 按配置计算掩码（分配内存）；内存不足时返回 false，mask 保持为空
+bool dim_mask_build(DimMask *mask, const DimMaskConfig *cfg);
+void dim_mask_free(DimMask *mask);
+
+// 以 alpha 为基准把掩码画到当前帧（左上角对齐，帧缓冲尺寸应与掩码分辨率一致）
+void dim_mask_draw(DimMask *mask, u8 alpha);
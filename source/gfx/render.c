@@ -0,0 +1,96 @@
+// 覆盖层绘制：所有原语都落到 blocklinear / blend / blit 内核上
+#include "render.h"
+#include "blend.h"
+
+static const RenderFramebuffer *g_fb = NULL;
+static void *g_currentFramebuffer = NULL;
+
+void renderBind(const RenderFramebuffer *fb) {
+    g_fb = fb;
+    g_currentFramebuffer = NULL;
+}
+
+void startFrame(void) {
+    g_currentFramebuffer = g_fb ? g_fb->begin(g_fb->ctx) : NULL;
+}
+
+void endFrame(bool vsyncAligned) {
+    if (g_fb && g_currentFramebuffer) g_fb->end(g_fb->ctx, vsyncAligned);
+    g_currentFramebuffer = NULL;
+}
+
+BlSurface currentSurface(void) {
+    if (g_fb == NULL) return (BlSurface){ 0 };
+    return (BlSurface){
+        .pixels = (u16 *)g_currentFramebuffer,
+        .width = g_fb->width,
+        .height = g_fb->height,
+        .stride = g_fb->stride,
+        .format = g_fb->format,
+    };
+}
+
+u32 getPixelOffset(s32 x, s32 y) {
+    // 边界由调用者保证，这里直接映射
+    BlSurface surface = currentSurface();
+    return bl_pixel_index(&surface, (u32)x, (u32)y);
+}
+
+static inline bool inFrame(s32 x, s32 y) {
+    return g_currentFramebuffer != NULL && x >= 0 && y >= 0 && x < (s32)g_fb->width && y < (s32)g_fb->height;
+}
+
+void setPixel(s32 x, s32 y, Color color) {
+    if (!inFrame(x, y)) return;
+    u32 px = color_pack(g_fb->format, color);
+    if (g_fb->format == BlFormat_RGBA8888) {
+        ((u32 *)g_currentFramebuffer)[getPixelOffset(x, y)] = px;
+    } else {
+        ((u16 *)g_currentFramebuffer)[getPixelOffset(x, y)] = (u16)px;
+    }
+}
+
+void setPixelBlendDst(s32 x, s32 y, Color color) {
+    if (!inFrame(x, y)) return;
+    // 整数混合，RGBA4444 下结果与 tesla.hpp 的 blendColor 逐位一致（见 blend.h）
+    u32 px = color_pack(g_fb->format, color);
+    if (g_fb->format == BlFormat_RGBA8888) {
+        u32 *pixel = (u32 *)g_currentFramebuffer + getPixelOffset(x, y);
+        *pixel = blend_pixel_8888(*pixel, px);
+    } else if (g_fb->format == BlFormat_RGB565A) {
+        u16 *pixel = (u16 *)g_currentFramebuffer + getPixelOffset(x, y);
+        *pixel = blend_pixel_565a(*pixel, px);
+    } else {
+        u16 *pixel = (u16 *)g_currentFramebuffer + getPixelOffset(x, y);
+        *pixel = blend_pixel(*pixel, (u16)px);
+    }
+}
+
+void drawRect(s32 x, s32 y, s32 w, s32 h, Color color) {
+    if (g_currentFramebuffer == NULL) return;
+    BlSurface surface = currentSurface();
+    bl_blend_rect(&surface, x, y, w, h, color_pack(surface.format, color));
+}
+
+void drawImage(s32 x, s32 y, const BlitImage *image, Color tint, bool blend) {
+    if (g_currentFramebuffer == NULL) return;
+    BlSurface surface = currentSurface();
+    bl_blit_image(&surface, x, y, image, color_pack(surface.format, tint), blend ? BlitFlag_Blend : BlitFlag_None);
+}
+
+void fillScreen(Color color) {
+    if (g_fb == NULL) return;
+    drawRect(0, 0, (s32)g_fb->width, (s32)g_fb->height, color);
+}
+
+void fillScreenSolid(Color color) {
+    if (g_currentFramebuffer == NULL) return;
+    BlSurface surface = currentSurface();
+    bl_fill(&surface, color_pack(surface.format, color));
+}
+
+void fillScreenSolid8(Color8 color) {
+    if (g_currentFramebuffer == NULL) return;
+    BlSurface surface = currentSurface();
+    bl_fill(&surface, color8_pack(surface.format, color));
+}
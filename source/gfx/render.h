@@ -0,0 +1,73 @@
+#pragma once
+
+// 覆盖层绘制接口（从 tesla Renderer 移植的部分）：与 libnx 无关，
+// 帧缓冲由 RenderFramebuffer 提供——sysmodule 中是 NWindow 帧缓冲，宿主上是一块内存
+#include <switch/types.h>
+#include "blocklinear.h"
+#include "blit.h"
+
+// 颜色结构（4bit RGBA）
+typedef struct { u8 r, g, b, a; } Color;
+
+// 8bit RGBA：RGBA8888 帧缓冲可以用满 256 级 alpha，其他格式按位数截断
+typedef struct { u8 r, g, b, a; } Color8;
+
+static inline u16 color_to_u16(Color c) {
+    return (u16)((c.r & 0xF) | ((c.g & 0xF) << 4) | ((c.b & 0xF) << 8) | ((c.a & 0xF) << 12));
+}
+
+// 4bit -> 8bit（x17，再截断回 4bit 时不变）
+static inline Color8 color_widen(Color c) {
+    return (Color8){ (u8)((c.r & 0xF) * 17), (u8)((c.g & 0xF) * 17), (u8)((c.b & 0xF) * 17), (u8)((c.a & 0xF) * 17) };
+}
+
+// 按帧缓冲格式打包
+static inline u32 color8_pack(BlFormat format, Color8 c) {
+    return bl_format_pack(format, c.r, c.g, c.b, c.a);
+}
+
+static inline u32 color_pack(BlFormat format, Color c) {
+    return format == BlFormat_RGBA4444 ? color_to_u16(c) : color8_pack(format, color_widen(c));
+}
+
+// 块线性帧缓冲
+typedef struct {
+    void *ctx;
+    u32 width;
+    u32 height;
+    u32 stride; // 每行字节数
+    BlFormat format;
+    // 取得下一帧可写的缓冲，失败返回 NULL
+    void *(*begin)(void *ctx);
+    // 提交当前帧；vsyncAligned 表示调用者刚被 vsync 唤醒，不必再等一次
+    void (*end)(void *ctx, bool vsyncAligned);
+} RenderFramebuffer;
+
+// 绑定帧缓冲（NULL 解除绑定）；fb 在解除绑定前必须保持有效
+void renderBind(const RenderFramebuffer *fb);
+
+// 帧控制
+void startFrame(void);
+void endFrame(bool vsyncAligned);
+
+// 当前帧对应的块线性表面（不在帧内时 pixels 为 NULL）
+BlSurface currentSurface(void);
+
+// 将 x,y 映射为块线性帧缓冲中的偏移（与 tesla.hpp getPixelOffset 的布局一致）
+u32 getPixelOffset(s32 x, s32 y);
+
+// 绘制基本原语
+void setPixel(s32 x, s32 y, Color color);
+void setPixelBlendDst(s32 x, s32 y, Color color);
+
+// 半透明矩形：按块线性布局整段混合
+void drawRect(s32 x, s32 y, s32 w, s32 h, Color color);
+
+// 贴图：RGBA4444 图像或以 tint 着色的 A4/A8 字形，blend 为 true 时按像素 alpha 叠加
+void drawImage(s32 x, s32 y, const BlitImage *image, Color tint, bool blend);
+
+void fillScreen(Color color);
+
+// 无混合的整屏填充（直接写入像素，保证底色和 alpha 精确）
+void fillScreenSolid(Color color);
+void fillScreenSolid8(Color8 color);
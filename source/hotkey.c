@@ -0,0 +1,84 @@
+// 亮度快捷键
+// 方向键按下的那一次立即调节，之后按住超过 HOTKEY_REPEAT_DELAY_NS 开始按固定间隔重复；
+// 上下同时按住视为都没按
+#include <strings.h>
+#include "hotkey.h"
+
+typedef struct {
+    const char *name;
+    u32 bit; // HidNpadButton 中的位
+} HotkeyButtonName;
+
+static const HotkeyButtonName g_buttonNames[] = {
+    { "A", 0 }, { "B", 1 }, { "X", 2 }, { "Y", 3 },
+    { "LS", 4 }, { "RS", 5 }, { "L", 6 }, { "R", 7 },
+    { "ZL", 8 }, { "ZR", 9 }, { "PLUS", 10 }, { "MINUS", 11 },
+    { "DLEFT", 12 }, { "DUP", 13 }, { "DRIGHT", 14 }, { "DDOWN", 15 },
+    { "LEFT", 12 }, { "UP", 13 }, { "RIGHT", 14 }, { "DOWN", 15 },
+};
+
+bool hotkey_parse_buttons(const char *text, u64 *out) {
+    u64 mask = 0;
+    const char *p = text;
+    while (*p == ' ') ++p;
+    if (*p == '\0' || strcasecmp(p, "none") == 0) {
+        *out = 0;
+        return true;
+    }
+
+    while (*p != '\0') {
+        const char *end = p;
+        while (*end != '\0' && *end != '+' && *end != ' ') ++end;
+        size_t len = (size_t)(end - p);
+        bool found = false;
+        for (size_t i = 0; i < sizeof(g_buttonNames) / sizeof(g_buttonNames[0]); ++i) {
+            const char *name = g_buttonNames[i].name;
+            if (strncasecmp(p, name, len) == 0 && name[len] == '\0') {
+                mask |= 1ULL << g_buttonNames[i].bit;
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+        p = end;
+        while (*p == ' ') ++p;
+        if (*p == '+') ++p;
+        while (*p == ' ') ++p;
+    }
+    *out = mask;
+    return mask != 0;
+}
+
+void hotkey_reset(HotkeyState *state) {
+    state->held = 0;
+    state->repeatAt = 0;
+}
+
+s32 hotkey_update(HotkeyState *state, const HotkeyConfig *cfg, u64 buttons, u64 now_ns) {
+    u64 pressed = buttons & ~state->held;
+    state->held = buttons;
+    if (!hotkey_engaged(cfg, buttons)) {
+        state->repeatAt = 0;
+        return 0;
+    }
+
+    bool up = cfg->up != 0 && (buttons & cfg->up) == cfg->up;
+    bool down = cfg->down != 0 && (buttons & cfg->down) == cfg->down;
+    if (up == down) {
+        state->repeatAt = 0;
+        return 0;
+    }
+    s32 delta = up ? cfg->step : -cfg->step;
+
+    if (pressed & (up ? cfg->up : cfg->down)) {
+        state->repeatAt = now_ns + HOTKEY_REPEAT_DELAY_NS;
+        return delta;
+    }
+    if (state->repeatAt != 0 && now_ns >= state->repeatAt) {
+        // 采样间隔大于重复间隔（如错过了几个 vsync）时不补发
+        state->repeatAt += HOTKEY_REPEAT_INTERVAL_NS;
+        if (state->repeatAt <= now_ns) state->repeatAt = now_ns + HOTKEY_REPEAT_INTERVAL_NS;
+        return delta;
+    }
+    return 0;
+}
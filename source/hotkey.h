@@ -0,0 +1,39 @@
+#pragma once
+
+// 亮度快捷键：按住修饰键（如 ZL+ZR）时按上/下调节亮度，按住不放时自动重复
+// 只把按键采样换算成亮度变化量，按键从 HID 共享内存读取、何时采样由主循环决定；
+// 按键位与 libnx 的 HidNpadButton 一致，时间以纳秒传入
+// （与平台无关：sysmodule 和宿主工具共用）
+#include <switch/types.h>
+
+#define HOTKEY_DEFAULT_STEP    5
+#define HOTKEY_DEFAULT_POLL_MS 100
+// 按住后第一次自动重复的延迟和之后的间隔
+#define HOTKEY_REPEAT_DELAY_NS    400000000ULL
+#define HOTKEY_REPEAT_INTERVAL_NS 100000000ULL
+
+typedef struct {
+    u64 modifiers; // 必须同时按住的键；0 表示未启用
+    u64 up;        // 调亮
+    u64 down;      // 调暗
+    s32 step;      // 每次调节的亮度（1-100）
+    u32 poll_ms;   // 修饰键未按住时的采样间隔
+} HotkeyConfig;
+
+typedef struct {
+    u64 held;     // 上一次采样时按住的键
+    u64 repeatAt; // 下一次自动重复的时刻，0 表示没有
+} HotkeyState;
+
+// 解析 "ZL+ZR"、"DUP" 这样的按键组合（不区分大小写）；"none" 或空串得到 0
+bool hotkey_parse_buttons(const char *text, u64 *out);
+
+void hotkey_reset(HotkeyState *state);
+
+// 修饰键是否全部按住：此时主循环应每个 vsync 采样一次
+static inline bool hotkey_engaged(const HotkeyConfig *cfg, u64 buttons) {
+    return cfg->modifiers != 0 && (buttons & cfg->modifiers) == cfg->modifiers;
+}
+
+// 处理一次采样，返回亮度变化量（正为调亮，0 表示不变）
+s32 hotkey_update(HotkeyState *state, const HotkeyConfig *cfg, u64 buttons, u64 now_ns);
@@ -0,0 +1,149 @@
+// 最小化的 CMIF 命名服务端
+#include <string.h>
+#include "ipc_server.h"
+
+Result ipcServerInit(IpcServer *server, const char *name, u32 max_sessions) {
+    if (max_sessions < 1 || max_sessions + 1 > IPC_SERVER_MAX_HANDLES) {
+        return MAKERESULT(Module_Libnx, LibnxError_BadInput);
+    }
+
+    server->srvName = smEncodeName(name);
+    server->max = max_sessions + 1;
+    server->count = 0;
+
+    Handle port;
+    Result rc = smRegisterService(&port, server->srvName, false, max_sessions);
+    if (R_SUCCEEDED(rc)) {
+        server->handles[0] = port;
+        server->count = 1;
+    }
+    return rc;
+}
+
+Result ipcServerExit(IpcServer *server) {
+    if (server->count == 0) return 0;
+
+    for (u32 i = 1; i < server->count; ++i) {
+        svcCloseHandle(server->handles[i]);
+    }
+    svcCloseHandle(server->handles[0]);
+    server->count = 0;
+    return smUnregisterService(server->srvName);
+}
+
+static void ipcServerDeleteSession(IpcServer *server, u32 index) {
+    svcCloseHandle(server->handles[index]);
+    // 用最后一个会话填补空位
+    server->handles[index] = server->handles[--server->count];
+}
+
+static Result ipcServerAcceptSession(IpcServer *server) {
+    Handle session;
+    Result rc = svcAcceptSession(&session, server->handles[0]);
+    if (R_FAILED(rc)) return rc;
+
+    if (server->count >= server->max) {
+        svcCloseHandle(session);
+        return MAKERESULT(Module_Libnx, LibnxError_OutOfMemory);
+    }
+
+    server->handles[server->count++] = session;
+    return 0;
+}
+
+static Result ipcServerParseRequest(IpcServerRequest *r) {
+    void *base = armGetTls();
+
+    r->hipc = hipcParseRequest(base);
+    r->cmd_id = 0;
+    r->data = NULL;
+    r->data_size = 0;
+
+    if (r->hipc.meta.type != CmifCommandType_Request) return 0;
+
+    CmifInHeader *header = (CmifInHeader *)cmifGetAlignedDataStart(r->hipc.data.data_words, base);
+    size_t data_size = r->hipc.meta.num_data_words * 4;
+    if (data_size < sizeof(CmifInHeader) || header->magic != CMIF_IN_HEADER_MAGIC) {
+        return MAKERESULT(Module_Libnx, LibnxError_BadInput);
+    }
+
+    r->cmd_id = header->command_id;
+    r->data = (const u8 *)header + sizeof(CmifInHeader);
+    // 包含对齐填充，处理函数只需检查是否足够大
+    r->data_size = data_size - sizeof(CmifInHeader);
+    return 0;
+}
+
+static void ipcServerPrepareResponse(Result rc, const IpcServerResponse *resp) {
+    void *base = armGetTls();
+    size_t data_size = R_SUCCEEDED(rc) ? resp->data_size : 0;
+    u32 num_copy_handles = R_SUCCEEDED(rc) ? resp->num_copy_handles : 0;
+
+    HipcRequest hipc = hipcMakeRequestInline(base,
+        .type = CmifCommandType_Invalid,
+        .num_data_words = (u32)((sizeof(CmifOutHeader) + data_size + 0x10 + 3) / 4),
+        .num_copy_handles = num_copy_handles,
+    );
+
+    for (u32 i = 0; i < num_copy_handles; ++i) {
+        hipc.copy_handles[i] = resp->copy_handles[i];
+    }
+
+    CmifOutHeader *header = (CmifOutHeader *)cmifGetAlignedDataStart(hipc.data_words, base);
+    header->magic = CMIF_OUT_HEADER_MAGIC;
+    header->version = 0;
+    header->result = rc;
+    header->token = 0;
+
+    if (data_size > 0) {
+        memcpy((u8 *)header + sizeof(CmifOutHeader), resp->data, data_size);
+    }
+}
+
+Result ipcServerProcess(IpcServer *server, IpcServerRequestHandler handler, void *userdata) {
+    s32 index = -1;
+    Result rc = svcReplyAndReceive(&index, server->handles, server->count, INVALID_HANDLE, UINT64_MAX);
+    if (R_FAILED(rc)) {
+        if (rc == KERNELRESULT(ConnectionClosed) && index > 0) {
+            ipcServerDeleteSession(server, (u32)index);
+            return 0;
+        }
+        return rc;
+    }
+
+    if (index == 0) {
+        return ipcServerAcceptSession(server);
+    }
+
+    u32 session = (u32)index;
+    IpcServerRequest r;
+    IpcServerResponse resp;
+    memset(&resp, 0, sizeof(resp));
+
+    rc = ipcServerParseRequest(&r);
+    if (R_SUCCEEDED(rc)) {
+        switch (r.hipc.meta.type) {
+            case CmifCommandType_Request:
+                rc = handler(userdata, &r, &resp);
+                break;
+            case CmifCommandType_Close:
+                ipcServerDeleteSession(server, session);
+                return 0;
+            default:
+                rc = MAKERESULT(Module_Libnx, LibnxError_BadInput);
+                break;
+        }
+    }
+
+    ipcServerPrepareResponse(rc, &resp);
+
+    // 仅回复，不等待新的请求
+    rc = svcReplyAndReceive(&index, NULL, 0, server->handles[session], 0);
+    if (rc == KERNELRESULT(TimedOut)) {
+        rc = 0;
+    }
+    if (R_FAILED(rc)) {
+        ipcServerDeleteSession(server, session);
+    }
+    return rc;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// 最小化的 CMIF 命名服务端：注册服务端口、接受会话、解析请求并回复
+#include <switch.h>
+
+#define IPC_SERVER_MAX_HANDLES 0x40
+
+typedef struct {
+    SmServiceName srvName;
+    Handle handles[IPC_SERVER_MAX_HANDLES]; // [0] 为服务端口，其余为会话
+    u32 max;
+    u32 count;
+} IpcServer;
+
+typedef struct {
+    u32 cmd_id;
+    const void *data;
+    size_t data_size;
+    HipcParsedRequest hipc;
+} IpcServerRequest;
+
+#define IPC_SERVER_MAX_RESPONSE     0x100
+#define IPC_SERVER_MAX_COPY_HANDLES 2
+
+// 回复写在 0x100 字节的 TLS 中，返回数据之前还有 HIPC 头、特殊头和复制句柄、数据区按 16 字节对齐的填充和 CmifOutHeader
+#define IPC_SERVER_RESPONSE_OVERHEAD                                                                     \
+    (sizeof(HipcHeader) + sizeof(HipcSpecialHeader) + IPC_SERVER_MAX_COPY_HANDLES * sizeof(Handle) + 0x10 \
+     + sizeof(CmifOutHeader))
+// 一条回复最多能带的返回数据
+#define IPC_SERVER_MAX_RESPONSE_DATA (0x100 - IPC_SERVER_RESPONSE_OVERHEAD)
+
+typedef struct {
+    u8 data[IPC_SERVER_MAX_RESPONSE];
+    size_t data_size;
+    Handle copy_handles[IPC_SERVER_MAX_COPY_HANDLES];
+    u32 num_copy_handles;
+} IpcServerResponse;
+
+// 处理一条请求：out 已清零，处理函数填写返回数据和需要复制给客户端的句柄
+typedef Result (*IpcServerRequestHandler)(void *userdata, const IpcServerRequest *r, IpcServerResponse *out);
+
+Result ipcServerInit(IpcServer *server, const char *name, u32 max_sessions);
+Result ipcServerExit(IpcServer *server);
+
+// 等待并处理一个事件（新会话、请求或会话关闭）；被 svcCancelSynchronization 取消时返回 KERNELRESULT(Cancelled)
+Result ipcServerProcess(IpcServer *server, IpcServerRequestHandler handler, void *userdata);
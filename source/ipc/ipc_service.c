@@ -0,0 +1,74 @@
+// DClight 控制服务：IPC 线程只负责收发，命令处理在 service.c 中
+#include "ipc_service.h"
+#include "ipc_server.h"
+#include "service.h"
+#include "mailbox.h"
+#include "../util/log.h"
+
+_Static_assert(SERVICE_MAX_OUT_SIZE <= IPC_SERVER_MAX_RESPONSE_DATA, "service output must fit in the TLS reply after its headers");
+
+#define IPC_THREAD_STACK_SIZE 0x3000
+#define IPC_THREAD_PRIORITY   0x2C
+
+static IpcServer g_server;
+static Thread g_thread;
+static bool g_running = false;
+
+static void ipc_service_notify(void *arg) {
+    ueventSignal((UEvent *)arg);
+}
+
+static Result ipc_service_handler(void *userdata, const IpcServerRequest *r, IpcServerResponse *out) {
+    // 需要传递内核句柄的命令在这里处理，其余交给与平台无关的 service_dispatch
+    if (r->cmd_id == DClightIpcCmd_GetMailbox) {
+        Result rc = mailbox_get_handles(&out->copy_handles[0], &out->copy_handles[1]);
+        if (R_SUCCEEDED(rc)) out->num_copy_handles = 2;
+        return rc;
+    }
+    return service_dispatch(r->cmd_id, r->data, r->data_size, out->data, &out->data_size);
+}
+
+static void ipc_service_thread(void *arg) {
+    while (__atomic_load_n(&g_running, __ATOMIC_ACQUIRE)) {
+        Result rc = ipcServerProcess(&g_server, ipc_service_handler, NULL);
+        if (rc == KERNELRESULT(Cancelled)) break;
+        if (R_FAILED(rc)) {
+            log_warning_ratelimited(1000, "ipcServerProcess 失败: 0x%x", rc);
+        }
+    }
+}
+
+Result ipc_service_start(UEvent *wake_event) {
+    service_init(ipc_service_notify, wake_event);
+
+    Result rc = ipcServerInit(&g_server, DCLIGHT_IPC_SERVICE_NAME, DCLIGHT_IPC_MAX_SESSIONS);
+    if (R_FAILED(rc)) return rc;
+
+    rc = threadCreate(&g_thread, ipc_service_thread, NULL, NULL, IPC_THREAD_STACK_SIZE, IPC_THREAD_PRIORITY, -2);
+    if (R_FAILED(rc)) {
+        ipcServerExit(&g_server);
+        return rc;
+    }
+
+    __atomic_store_n(&g_running, true, __ATOMIC_RELEASE);
+    rc = threadStart(&g_thread);
+    if (R_FAILED(rc)) {
+        __atomic_store_n(&g_running, false, __ATOMIC_RELEASE);
+        threadClose(&g_thread);
+        ipcServerExit(&g_server);
+        return rc;
+    }
+
+    log_info("IPC 服务 \"%s\" 已启动", DCLIGHT_IPC_SERVICE_NAME);
+    return 0;
+}
+
+void ipc_service_stop(void) {
+    if (!__atomic_load_n(&g_running, __ATOMIC_ACQUIRE)) return;
+
+    __atomic_store_n(&g_running, false, __ATOMIC_RELEASE);
+    svcCancelSynchronization(g_thread.handle);
+    threadWaitForExit(&g_thread);
+    threadClose(&g_thread);
+    ipcServerExit(&g_server);
+}
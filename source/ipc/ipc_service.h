@@ -0,0 +1,8 @@
+#pragma once
+
+// DClight 控制服务：在独立线程上托管命名服务 "dclight"
+#include <switch.h>
+
+// 启动服务线程；收到调节请求时触发 wake_event 唤醒主循环
+Result ipc_service_start(UEvent *wake_event);
+void ipc_service_stop(void);
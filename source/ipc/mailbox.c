@@ -0,0 +1,77 @@
+// 共享内存信箱（sysmodule 端）
+#include <string.h>
+#include "mailbox.h"
+#include "../util/log.h"
+
+static SharedMemory g_shmem;
+static Event g_doorbell;
+static DClightMailbox *g_mailbox = NULL;
+static u32 g_lastGeneration = 0;
+static DClightMailboxStatus g_lastStatus;
+
+Result mailbox_init(void) {
+    Result rc = shmemCreate(&g_shmem, DCLIGHT_MAILBOX_SIZE, Perm_Rw, Perm_Rw);
+    if (R_FAILED(rc)) return rc;
+
+    rc = shmemMap(&g_shmem);
+    if (R_FAILED(rc)) {
+        shmemClose(&g_shmem);
+        return rc;
+    }
+
+    rc = eventCreate(&g_doorbell, true);
+    if (R_FAILED(rc)) {
+        shmemClose(&g_shmem);
+        return rc;
+    }
+
+    g_mailbox = (DClightMailbox *)shmemGetAddr(&g_shmem);
+    memset(g_mailbox, 0, DCLIGHT_MAILBOX_SIZE);
+    g_mailbox->magic = DCLIGHT_MAILBOX_MAGIC;
+    g_mailbox->version = DCLIGHT_MAILBOX_VERSION;
+    g_mailbox->control.brightness = DCLIGHT_BRIGHTNESS_NONE;
+    g_lastGeneration = 0;
+    memset(&g_lastStatus, 0xFF, sizeof(g_lastStatus));
+
+    log_info("共享内存信箱已创建 (%u 字节)", DCLIGHT_MAILBOX_SIZE);
+    return 0;
+}
+
+void mailbox_exit(void) {
+    if (g_mailbox == NULL) return;
+    eventClose(&g_doorbell);
+    shmemClose(&g_shmem);
+    g_mailbox = NULL;
+}
+
+Event *mailbox_doorbell(void) {
+    return g_mailbox ? &g_doorbell : NULL;
+}
+
+Result mailbox_get_handles(Handle *out_shmem, Handle *out_doorbell) {
+    if (g_mailbox == NULL) return MAKERESULT(Module_Libnx, LibnxError_NotInitialized);
+    *out_shmem = shmemGetHandle(&g_shmem);
+    *out_doorbell = g_doorbell.wevent;
+    return 0;
+}
+
+bool mailbox_poll(DClightMailboxControl *out) {
+    if (g_mailbox == NULL) return false;
+    if (dclightMailboxControlGeneration(g_mailbox) == g_lastGeneration) return false;
+    if (!dclightMailboxControlLoad(g_mailbox, out)) return false;
+
+    g_lastGeneration = out->generation;
+    return true;
+}
+
+void mailbox_publish(const DClightMailboxStatus *status) {
+    if (g_mailbox == NULL) return;
+
+    DClightMailboxStatus st = *status;
+    st.seq = 0;
+    st.generation = g_lastGeneration;
+    if (memcmp(&st, &g_lastStatus, sizeof(st)) == 0) return;
+
+    dclightMailboxStatusStore(g_mailbox, &st);
+    g_lastStatus = st;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// 共享内存信箱（sysmodule 端）：创建共享内存页和 doorbell 事件，通过 GetMailbox 命令交给 NRO
+#include <switch.h>
+#include <dclight/mailbox.h>
+
+Result mailbox_init(void);
+void mailbox_exit(void);
+
+// doorbell 读端：NRO 提交后触发，主循环等待它；未初始化时返回 NULL
+Event *mailbox_doorbell(void);
+
+// 共享内存句柄和 doorbell 写端（由 IPC 复制给客户端）
+Result mailbox_get_handles(Handle *out_shmem, Handle *out_doorbell);
+
+// 检查 control.generation 是否变化（只读内存，不做系统调用）；变化时返回 true 并输出快照
+bool mailbox_poll(DClightMailboxControl *out);
+
+// 发布覆盖层当前状态；内容未变化时不写共享内存
+void mailbox_publish(const DClightMailboxStatus *status);
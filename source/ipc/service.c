@@ -0,0 +1,158 @@
+// DClight 控制服务的命令处理
+// 请求与状态都用原子变量在 IPC 线程和主循环之间传递，不需要锁
+#include <string.h>
+#include "service.h"
+
+// 请求打包为一个字：高 16 位为 ServiceRequestKind，低 16 位为值
+#define REQUEST_PACK(kind, value) (((u32)(kind) << 16) | ((value) & 0xFFFF))
+
+static u32 g_request = 0;
+static bool g_reload = false;
+static DClightStatus g_status = {
+    .api_version = DCLIGHT_IPC_API_VERSION,
+    .brightness = DCLIGHT_BRIGHTNESS_NONE,
+    .presented_alpha = DCLIGHT_ALPHA_NONE,
+};
+static ServiceNotifyFn g_notify = NULL;
+static void *g_notifyArg = NULL;
+static ServiceMemoryFn g_memorySource = NULL;
+static ServiceBootTraceFn g_bootTraceSource = NULL;
+static ServiceMetricsFn g_metricsSource = NULL;
+
+void service_init(ServiceNotifyFn notify, void *arg) {
+    g_notify = notify;
+    g_notifyArg = arg;
+    __atomic_store_n(&g_request, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_reload, false, __ATOMIC_RELAXED);
+}
+
+static void service_post_request(ServiceRequestKind kind, u32 value) {
+    __atomic_store_n(&g_request, REQUEST_PACK(kind, value), __ATOMIC_RELEASE);
+    if (g_notify) g_notify(g_notifyArg);
+}
+
+void service_set_memory_source(ServiceMemoryFn fn) {
+    g_memorySource = fn;
+}
+
+void service_set_boot_trace_source(ServiceBootTraceFn fn) {
+    g_bootTraceSource = fn;
+}
+
+void service_set_metrics_source(ServiceMetricsFn fn) {
+    g_metricsSource = fn;
+}
+
+bool service_take_request(ServiceRequest *out) {
+    u32 packed = __atomic_exchange_n(&g_request, 0, __ATOMIC_ACQUIRE);
+    if (packed == 0) return false;
+    out->kind = (ServiceRequestKind)(packed >> 16);
+    out->value = packed & 0xFFFF;
+    return true;
+}
+
+bool service_take_reload(void) {
+    return __atomic_exchange_n(&g_reload, false, __ATOMIC_ACQUIRE);
+}
+
+void service_publish_status(const DClightStatus *status) {
+    __atomic_store_n(&g_status.brightness, status->brightness, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_status.alpha, status->alpha, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_status.presented_alpha, status->presented_alpha, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_status.flags, status->flags, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_status.config_reloads, status->config_reloads, __ATOMIC_RELAXED);
+}
+
+static void service_read_status(DClightStatus *out) {
+    out->api_version = DCLIGHT_IPC_API_VERSION;
+    out->brightness = __atomic_load_n(&g_status.brightness, __ATOMIC_RELAXED);
+    out->alpha = __atomic_load_n(&g_status.alpha, __ATOMIC_RELAXED);
+    out->presented_alpha = __atomic_load_n(&g_status.presented_alpha, __ATOMIC_RELAXED);
+    out->flags = __atomic_load_n(&g_status.flags, __ATOMIC_RELAXED);
+    out->config_reloads = __atomic_load_n(&g_status.config_reloads, __ATOMIC_RELAXED);
+}
+
+static bool service_read_u32(const void *in, size_t in_size, u32 *out) {
+    if (in == NULL || in_size < sizeof(u32)) return false;
+    memcpy(out, in, sizeof(u32));
+    return true;
+}
+
+Result service_dispatch(u32 cmd, const void *in, size_t in_size, void *out, size_t *out_size) {
+    DClightStatus status;
+    u32 value;
+    *out_size = 0;
+
+    switch (cmd) {
+        case DClightIpcCmd_GetApiVersion:
+            value = DCLIGHT_IPC_API_VERSION;
+            memcpy(out, &value, sizeof(value));
+            *out_size = sizeof(value);
+            return 0;
+
+        case DClightIpcCmd_GetBrightness:
+            service_read_status(&status);
+            memcpy(out, &status.brightness, sizeof(status.brightness));
+            *out_size = sizeof(status.brightness);
+            return 0;
+
+        case DClightIpcCmd_SetBrightness:
+            if (!service_read_u32(in, in_size, &value) || value > DCLIGHT_BRIGHTNESS_MAX)
+                return DCLIGHT_ERROR(InvalidArgument);
+            service_post_request(ServiceRequest_Brightness, value);
+            return 0;
+
+        case DClightIpcCmd_GetAlpha:
+            service_read_status(&status);
+            memcpy(out, &status.alpha, sizeof(status.alpha));
+            *out_size = sizeof(status.alpha);
+            return 0;
+
+        case DClightIpcCmd_SetAlpha:
+            if (!service_read_u32(in, in_size, &value) || value > DCLIGHT_ALPHA_MAX)
+                return DCLIGHT_ERROR(InvalidArgument);
+            service_post_request(ServiceRequest_Alpha, value);
+            return 0;
+
+        case DClightIpcCmd_GetStatus:
+            service_read_status(&status);
+            memcpy(out, &status, sizeof(status));
+            *out_size = sizeof(status);
+            return 0;
+
+        case DClightIpcCmd_ReloadConfig:
+            __atomic_store_n(&g_reload, true, __ATOMIC_RELEASE);
+            if (g_notify) g_notify(g_notifyArg);
+            return 0;
+
+        case DClightIpcCmd_GetMemoryStats: {
+            if (g_memorySource == NULL) return DCLIGHT_ERROR(NotAvailable);
+            DClightMemoryStats stats = {0};
+            g_memorySource(&stats);
+            memcpy(out, &stats, sizeof(stats));
+            *out_size = sizeof(stats);
+            return 0;
+        }
+
+        case DClightIpcCmd_GetBootTrace: {
+            if (g_bootTraceSource == NULL) return DCLIGHT_ERROR(NotAvailable);
+            DClightBootTrace trace = {0};
+            g_bootTraceSource(&trace);
+            memcpy(out, &trace, sizeof(trace));
+            *out_size = sizeof(trace);
+            return 0;
+        }
+
+        case DClightIpcCmd_GetMetrics: {
+            if (g_metricsSource == NULL) return DCLIGHT_ERROR(NotAvailable);
+            DClightMetrics metrics = {0};
+            g_metricsSource(&metrics);
+            memcpy(out, &metrics, sizeof(metrics));
+            *out_size = sizeof(metrics);
+            return 0;
+        }
+
+        default:
+            return DCLIGHT_ERROR(UnknownCommand);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// DClight 控制服务的命令处理（与平台无关：sysmodule 的 IPC 线程和 Linux 替身服务共用）
+#include <stddef.h>
+#include <switch/types.h>
+#include <switch/result.h>
+#include <dclight/ipc.h>
+
+typedef enum {
+    ServiceRequest_None = 0,
+    ServiceRequest_Brightness,
+    ServiceRequest_Alpha,
+} ServiceRequestKind;
+
+// IPC 下发、等待主循环应用的调节请求（只保留最新一个）
+typedef struct {
+    ServiceRequestKind kind;
+    u32 value;
+} ServiceRequest;
+
+// 有新请求时在 IPC 线程上调用，用于唤醒主循环
+typedef void (*ServiceNotifyFn)(void *arg);
+
+// 在 IPC 线程上读取内存统计
+typedef void (*ServiceMemoryFn)(DClightMemoryStats *out);
+
+// 在 IPC 线程上读取启动计时
+typedef void (*ServiceBootTraceFn)(DClightBootTrace *out);
+
+// 在 IPC 线程上读取运行时统计
+typedef void (*ServiceMetricsFn)(DClightMetrics *out);
+
+void service_init(ServiceNotifyFn notify, void *arg);
+
+// 设置 GetMemoryStats 的数据来源；未设置时该命令返回 NotAvailable
+void service_set_memory_source(ServiceMemoryFn fn);
+
+// 设置 GetBootTrace 的数据来源；未设置时该命令返回 NotAvailable
+void service_set_boot_trace_source(ServiceBootTraceFn fn);
+
+// 设置 GetMetrics 的数据来源；未设置时该命令返回 NotAvailable
+void service_set_metrics_source(ServiceMetricsFn fn);
+
+// 命令输出的最大长度
+#define SERVICE_MAX_(a, b) ((a) > (b) ? (a) : (b))
+#define SERVICE_MAX_OUT_SIZE SERVICE_MAX_(sizeof(DClightBootTrace), sizeof(DClightMetrics))
+
+// 处理一条命令：in 为请求参数，out 至少 SERVICE_MAX_OUT_SIZE 字节，*out_size 返回写入长度
+Result service_dispatch(u32 cmd, const void *in, size_t in_size, void *out, size_t *out_size);
+
+// 主循环：取走最新的调节请求；没有请求时返回 false
+bool service_take_request(ServiceRequest *out);
+
+// 主循环：是否收到 ReloadConfig 命令（读取后清除）
+bool service_take_reload(void);
+
+// 主循环：发布当前生效的状态，供 Get* 命令读取
+void service_publish_status(const DClightStatus *status);
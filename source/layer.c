@@ -0,0 +1,123 @@
+// VI 图层辅助
+#include "layer.h"
+#include "gfx/render.h"
+#include "metrics.h"
+
+// libnx 在 vi.c 中提供的弱符号：用于让 viCreateLayer 关联到已创建的 Managed Layer
+extern u64 __nx_vi_layer_id;
+
+// VI 层栈添加/移除（tesla.hpp 使用的辅助函数）
+Result viAddToLayerStack(ViLayer *layer, ViLayerStack stack) {
+    const struct {
+        u32 stack;
+        u64 layerId;
+    } in = { stack, layer->layer_id };
+    return serviceDispatchIn(viGetSession_IManagerDisplayService(), 6000, in);
+}
+
+Result viRemoveFromLayerStack(ViLayer *layer, ViLayerStack stack) {
+    const struct {
+        u32 stack;
+        u64 layerId;
+    } in = { stack, layer->layer_id };
+    return serviceDispatchIn(viGetSession_IManagerDisplayService(), 6001, in);
+}
+
+// 保守策略：仅添加到必要的图层栈（Default + Screenshot）
+Result layer_show(ViLayer *layer) {
+    Result rc = viAddToLayerStack(layer, ViLayerStack_Default);
+    if (R_FAILED(rc)) return rc;
+    return viAddToLayerStack(layer, ViLayerStack_Screenshot);
+}
+
+void layer_hide(ViLayer *layer) {
+    viRemoveFromLayerStack(layer, ViLayerStack_Default);
+    viRemoveFromLayerStack(layer, ViLayerStack_Screenshot);
+}
+
+Result layer_open(ViDisplay *display, ViLayer *layer, s32 z, s32 x, s32 y, s32 w, s32 h) {
+    Result rc = viCreateManagedLayer(display, (ViLayerFlags)0, 0, &__nx_vi_layer_id);
+    if (R_FAILED(rc)) return rc;
+    rc = viCreateLayer(display, layer);
+    if (R_FAILED(rc)) {
+        // layer 没有初始化，按 viCreateManagedLayer 给出的 ID 销毁
+        ViLayer managed = { .layer_id = __nx_vi_layer_id, .initialized = true };
+        viDestroyManagedLayer(&managed);
+        return rc;
+    }
+
+    rc = viSetLayerScalingMode(layer, ViScalingMode_FitToLayer);
+    if (R_SUCCEEDED(rc)) rc = viSetLayerZ(layer, z);
+    if (R_SUCCEEDED(rc)) rc = layer_set_rect(layer, x, y, w, h);
+    if (R_FAILED(rc)) goto fail_layer;
+    // 可能只加入了 Default 栈，失败时两个栈都移除
+    rc = layer_show(layer);
+    if (R_FAILED(rc)) goto fail_stack;
+    return 0;
+
+fail_stack:
+    layer_hide(layer);
+fail_layer:
+    viDestroyManagedLayer(layer);
+    return rc;
+}
+
+Result layer_create(ViDisplay *display, ViLayer *layer, NWindow *window, Framebuffer *fb, s32 z,
+                    s32 x, s32 y, s32 w, s32 h, u32 fb_width, u32 fb_height) {
+    Result rc = layer_open(display, layer, z, x, y, w, h);
+    if (R_FAILED(rc)) return rc;
+
+    rc = nwindowCreateFromLayer(window, layer);
+    if (R_FAILED(rc)) goto fail_layer;
+    rc = framebufferCreate(fb, window, fb_width, fb_height, PIXEL_FORMAT_RGBA_4444, 1);
+    if (R_FAILED(rc)) goto fail_window;
+    return 0;
+
+fail_window:
+    nwindowClose(window);
+fail_layer:
+    layer_hide(layer);
+    viDestroyManagedLayer(layer);
+    return rc;
+}
+
+Result layer_set_rect(ViLayer *layer, s32 x, s32 y, s32 w, s32 h) {
+    Result rc = viSetLayerSize(layer, w, h);
+    if (R_FAILED(rc)) return rc;
+    return viSetLayerPosition(layer, x, y);
+}
+
+void layer_destroy(ViLayer *layer, NWindow *window, Framebuffer *fb) {
+    framebufferClose(fb);
+    nwindowClose(window);
+    viDestroyManagedLayer(layer);
+}
+
+Result dim_layer_create(DimLayer *dl, ViDisplay *display, s32 z, s32 x, s32 y, s32 w, s32 h) {
+    dl->presentedAlpha = -1;
+    return layer_create(display, &dl->layer, &dl->window, &dl->fb, z, x, y, w, h, 1, 1);
+}
+
+Result dim_layer_set_rect(DimLayer *dl, s32 x, s32 y, s32 w, s32 h) {
+    return layer_set_rect(&dl->layer, x, y, w, h);
+}
+
+bool dim_layer_present(DimLayer *dl, u8 alpha) {
+    if (dl->presentedAlpha == (s32)alpha) return false;
+    u64 start = armGetSystemTick();
+    void *pixels = framebufferBegin(&dl->fb, NULL);
+    u64 dequeued = armGetSystemTick();
+    metrics_time(MetricTime_FbBegin, dequeued - start);
+    if (pixels == NULL) return false;
+    BlSurface surface = { .pixels = pixels, .width = 1, .height = 1, .stride = dl->fb.stride };
+    bl_fill(&surface, color_to_u16((Color){ 0, 0, 0, alpha }));
+    u64 filled = armGetSystemTick();
+    framebufferEnd(&dl->fb);
+    metrics_time(MetricTime_FbEnd, armGetSystemTick() - filled);
+    dl->presentedAlpha = alpha;
+    return true;
+}
+
+void dim_layer_destroy(DimLayer *dl) {
+    layer_destroy(&dl->layer, &dl->window, &dl->fb);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// VI 图层辅助：全屏覆盖层和区域图层共用
+#include <switch.h>
+
+// 屏幕分辨率（与 tesla.hpp 对齐）：全屏覆盖层的尺寸，也是区域和指示器使用的屏幕坐标系
+#define SCREEN_WIDTH  1920
+#define SCREEN_HEIGHT 1080
+
+// IManagerDisplayService 中 libnx 没有封装的命令
+Result viAddToLayerStack(ViLayer *layer, ViLayerStack stack);
+Result viRemoveFromLayerStack(ViLayer *layer, ViLayerStack stack);
+
+// 覆盖层所在的图层栈（Default + Screenshot）
+Result layer_show(ViLayer *layer);
+void layer_hide(ViLayer *layer);
+
+// 创建 Managed Layer，设置 FitToLayer、Z 和 (x, y, w, h) 并加入图层栈；失败时已创建的部分全部撤销
+Result layer_open(ViDisplay *display, ViLayer *layer, s32 z, s32 x, s32 y, s32 w, s32 h);
+// layer_open 之后在上面建 fb_width x fb_height 的单缓冲 RGBA4444 帧缓冲，
+// 由合成器按 FitToLayer 显示在 (x, y, w, h)；单缓冲让上一帧的内容保留到下一次 framebufferBegin
+Result layer_create(ViDisplay *display, ViLayer *layer, NWindow *window, Framebuffer *fb, s32 z,
+                    s32 x, s32 y, s32 w, s32 h, u32 fb_width, u32 fb_height);
+Result layer_set_rect(ViLayer *layer, s32 x, s32 y, s32 w, s32 h);
+void layer_destroy(ViLayer *layer, NWindow *window, Framebuffer *fb);
+
+// 一个只有 1x1 帧缓冲的暗化图层，由合成器按 FitToLayer 放大到图层尺寸
+typedef struct {
+    ViLayer layer;
+    NWindow window;
+    Framebuffer fb;
+    s32 presentedAlpha; // -1 表示尚未提交
+} DimLayer;
+
+Result dim_layer_create(DimLayer *dl, ViDisplay *display, s32 z, s32 x, s32 y, s32 w, s32 h);
+Result dim_layer_set_rect(DimLayer *dl, s32 x, s32 y, s32 w, s32 h);
+// 只在 alpha 变化时提交；返回是否提交了新的一帧
+bool dim_layer_present(DimLayer *dl, u8 alpha);
+void dim_layer_destroy(DimLayer *dl);
@@ -4,6 +4,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include "util/log.h"
+#include "config.h"
+#include "ipc/ipc_service.h"
+#include "ipc/service.h"
+#include "ipc/mailbox.h"
+#include "sched.h"
+#include "ramp.h"
+#include "gfx/render.h"
+#include "gfx/mask.h"
+#include "layer.h"
+#include "regions.h"
+#include "memstats.h"
+#include "profile.h"
+#include "title.h"
+#include "schedule.h"
+#include "boottrace.h"
+#include "metrics.h"
+#include "power.h"
+#include "power_psc.h"
+#include "hotkey.h"
+#include "cmu.h"
+#include "cmu_vi.h"
+#include "osd.h"
 
 // libnx 头文件
 #include <switch.h>
@@ -18,19 +40,15 @@
 #include <switch/nvidia/map.h>
 #include <switch/nvidia/fence.h>
 
-// minIni for INI reading
-#include "minIni.h"
-
 // 覆盖 libnx 的弱符号以强制 NV 服务类型和 tmem 大小（避免卡住）
 NvServiceType __attribute__((weak)) __nx_nv_service_type = NvServiceType_Application; // 默认 Auto 在 sysmodule 会选 System；强制走 nvdrv(u)
-u32 __attribute__((weak)) __nx_nv_transfermem_size = 0x64000; // 将 tmem 从 8MB 降到 400KB，规避大内存问题
+u32 __attribute__((weak)) __nx_nv_transfermem_size = DCLIGHT_NV_TMEM_SIZE; // 将 tmem 从 8MB 降到 400KB（精简模式 256KB），规避大内存问题
 
-// 内部堆大小（按需调整）
-#define INNER_HEAP_SIZE 0xAF000
+// 内部堆大小（按需调整；精简模式见 memstats.h）
+#define INNER_HEAP_SIZE DCLIGHT_HEAP_SIZE
 
-// 屏幕分辨率（与 tesla.hpp 对齐）
-#define SCREEN_WIDTH 1920
-#define SCREEN_HEIGHT 1080
+// 覆盖层图层（全屏图层和区域图层）的 Z 序
+#define OVERLAY_LAYER_Z 250
 
 // 配置项（与 tesla cfg 对齐）
 static u16 CFG_FramebufferWidth = 1;
@@ -46,146 +64,413 @@ static ViLayer g_layer;
 static Event g_vsyncEvent;
 static NWindow g_window;
 static Framebuffer g_framebuffer;
-static void *g_currentFramebuffer = NULL;
 static bool g_gfxInitialized = false;
+// 最近一次提交给合成器的暗化 alpha（-1 表示尚未提交过）
+static s32 g_presentedAlpha = -1;
+// 8 位 alpha 的帧缓冲上最近一次提交的 0-255 等级（只在 g_presentedAlpha 相同时有意义）
+static s32 g_presentedAlpha8 = -1;
+// 暗化图层帧缓冲的像素格式（fb_format）；RGB565A 没有逐像素 alpha，不会用在这里
+static BlFormat g_fbFormat = BlFormat_RGBA4444;
+
+// 当前使用的暗化后端；使用 CMU 时全屏图层不在图层栈中
+static DimBackend g_backend = DimBackend_Layer;
+static CmuBackend g_cmu;
+
+// 主循环唤醒事件：IPC 调节请求到达时触发，新亮度在下一帧生效
+static UEvent g_wakeEvent;
+
+// 配置文件变化后等待时间戳稳定期间的检查间隔
+#define CONFIG_SETTLE_POLL_NS   500000000ULL
+// 无法获取文件时间戳时的固定检查间隔
+#define CONFIG_FALLBACK_POLL_NS 500000000ULL
+
+// 当前生效的暗化状态（来自 config.ini 或 IPC，以最近一次变化为准）
+typedef struct {
+    s32 brightness; // 0-100，或 DCLIGHT_BRIGHTNESS_NONE（由 alpha 直接指定）
+    u8 alpha;       // 目标 alpha；过渡期间实际提交的值见 g_ramp
+    u8 alpha8;      // 同一目标换算到 0-255（由亮度得出时不限于 16 级），RGBA8888 的均匀暗化按它绘制
+    u32 rampMs;     // 向目标过渡的时长
+    bool fromIpc;
+    u32 configReloads;
+} DimState;
+
+// 当前暗化等级的过渡（从上一次的目标插值到 DimState.alpha 和 alpha8）
+static DimRamp g_ramp;
+
+// 按应用的配置表（配置变化时整体替换）
+static ProfileTable g_profiles;
+// 按时间的亮度计划（[schedule] 节）
+static Schedule g_schedule;
+// 区域列表（[regions] 节）
+static DimRegionList g_regions;
+
+// 亮度快捷键：只读取 HID 共享内存，不改变系统的手柄配置（hid 在 app_init_late 中初始化）
+static bool g_hidReady = false;
+static PadState g_pad;
+static HotkeyConfig g_hotkeyConfig;
+static HotkeyState g_hotkey;
+// 等待写入 config.ini 的亮度，-1 表示没有；写入的节：0 为 [DClight]，否则为该应用的 [title_<id>]
+static s32 g_hotkeySaveValue = -1;
+static u64 g_hotkeySaveTitle = 0;
+
+_Static_assert(BIT(8) == HidNpadButton_ZL && BIT(13) == HidNpadButton_Up && BIT(15) == HidNpadButton_Down,
+               "hotkey.c 的按键位应与 HidNpadButton 一致");
+
+// 亮度指示器的显示时长（indicator_ms），0 表示不显示
+static u32 g_indicatorMs = CONFIG_DEFAULT_INDICATOR_MS;
+
+// 快捷键调节停止这么久之后才写入 config.ini
+#define HOTKEY_SAVE_DELAY_NS   (3ULL * 1000000000ULL)
+// 修饰键按住但等不到 vsync（图形初始化失败）时的采样间隔
+#define HOTKEY_ENGAGED_POLL_NS 16000000ULL
 
-// VI 层栈添加（tesla.hpp 使用的辅助函数）
-static Result viAddToLayerStack(ViLayer *layer, ViLayerStack stack) {
-    const struct {
-        u32 stack;
-        u64 layerId;
-    } in = { stack, layer->layer_id };
-    return serviceDispatchIn(viGetSession_IManagerDisplayService(), 6000, in);
+// 计划的下一次变化最多等这么久：用户修改时钟或时区后，最晚在这之后按新时间重新计算
+#define SCHEDULE_MAX_SLEEP_NS (3600ULL * 1000000000ULL)
+// 读不到本地时间时的重试间隔
+#define SCHEDULE_RETRY_NS     (60ULL * 1000000000ULL)
+
+// 读取全局配置、各应用的配置和亮度计划
+static void load_config_from_ini(OverlayConfig *cfg) {
+    ProfileTable profiles;
+    config_load(cfg, &profiles, &g_schedule, &g_regions);
+    profile_table_free(&g_profiles);
+    g_profiles = profiles;
+    log_info("ini brightness=%ld, alpha_override=%ld, %u 个应用配置, %u 个计划时间点, %u 个区域 (path=%s)",
+             cfg->brightness, cfg->alpha, g_profiles.count, g_schedule.count, g_regions.count, CONFIG_INI_PATH);
 }
 
-// libnx 在 vi.c 中提供的弱符号：用于让 viCreateLayer 关联到已创建的 Managed Layer
-extern u64 __nx_vi_layer_id;
+// 快速启动的第一帧只需要全局配置：不建应用配置表，也不解析计划和区域
+static void load_global_config(OverlayConfig *cfg) {
+    config_load(cfg, NULL, NULL, NULL);
+    log_info("ini brightness=%ld, alpha_override=%ld（快速启动，完整配置在第一帧之后读取）", cfg->brightness, cfg->alpha);
+}
 
-// 颜色结构（4bit RGBA）
-typedef struct { u8 r, g, b, a; } Color;
+// 本地时间是当天的第几秒
+static bool local_time_of_day(u32 *out_second) {
+    u64 timestamp = 0;
+    if (R_FAILED(timeGetCurrentTime(TimeType_LocalSystemClock, &timestamp))) return false;
+    TimeCalendarTime cal;
+    TimeCalendarAdditionalInfo info;
+    if (R_FAILED(timeToCalendarTimeWithMyRule(timestamp, &cal, &info))) return false;
+    *out_second = (u32)cal.hour * 3600 + (u32)cal.minute * 60 + cal.second;
+    return true;
+}
 
-static inline u16 color_to_u16(Color c) {
-    return (u16)((c.r & 0xF) | ((c.g & 0xF) << 4) | ((c.b & 0xF) << 8) | ((c.a & 0xF) << 12));
+// 当前生效的配置：全局配置，计划启用时由计划给出亮度，再叠加当前应用的 [title_<id>] 节
+// timeOfDay 为 NULL 表示不使用计划
+static void resolve_config(const OverlayConfig *ini, u64 titleId, const u32 *timeOfDay, OverlayConfig *out) {
+    *out = *ini;
+    if (timeOfDay) {
+        out->brightness = schedule_brightness_at(&g_schedule, *timeOfDay);
+    }
+    const TitleProfile *profile = profile_lookup(&g_profiles, titleId);
+    if (profile) config_apply_profile(out, profile);
 }
 
-static inline Color color_from_u16(u16 raw) {
-    Color c;
-    c.r = (raw >> 0) & 0xF;
-    c.g = (raw >> 4) & 0xF;
-    c.b = (raw >> 8) & 0xF;
-    c.a = (raw >> 12) & 0xF;
-    return c;
+// 应用 IPC 下发的调节请求
+static void apply_service_request(DimState *state, const ServiceRequest *req) {
+    switch (req->kind) {
+        case ServiceRequest_Brightness:
+            state->brightness = (s32)req->value;
+            state->alpha = config_brightness_to_alpha(req->value);
+            state->alpha8 = config_brightness_to_alpha8(req->value);
+            break;
+        case ServiceRequest_Alpha:
+            state->brightness = DCLIGHT_BRIGHTNESS_NONE;
+            state->alpha = (u8)req->value;
+            state->alpha8 = config_alpha_to_alpha8(state->alpha);
+            break;
+        default:
+            return;
+    }
+    state->fromIpc = true;
 }
 
-// 像素混合（与 tesla.hpp 的 blendColor 一致）
-static inline u8 blendColor(u8 src, u8 dst, u8 alpha) {
-    u8 oneMinusAlpha = 0x0F - alpha;
-    // 使用浮点以匹配 tesla.hpp 行为
-    return (u8)((dst * alpha + src * oneMinusAlpha) / (float)0xF);
+// 当前亮度（0-100）；由 alpha 直接指定时按 alpha 折算
+static s32 state_brightness(const DimState *state) {
+    return state->brightness >= 0 ? state->brightness
+        : DCLIGHT_BRIGHTNESS_MAX - (s32)state->alpha * DCLIGHT_BRIGHTNESS_MAX / DCLIGHT_ALPHA_MAX;
 }
 
-// 将 x,y 映射为块线性帧缓冲中的偏移（与 tesla.hpp getPixelOffset 一致）
-static inline u32 getPixelOffset(s32 x, s32 y) {
-    // 边界由调用者保证，这里直接映射
-    u32 tmpPos = ((y & 127) / 16) + (x / 32 * 8) + ((y / 16 / 8) * (((CFG_FramebufferWidth / 2) / 16 * 8)));
-    tmpPos *= 16 * 16 * 4;
-    tmpPos += ((y % 16) / 8) * 512 + ((x % 32) / 16) * 256 + ((y % 8) / 2) * 64 + ((x % 16) / 8) * 32 + (y % 2) * 16 + (x % 8) * 2;
-    return tmpPos / 2;
+// 快捷键调节：在当前亮度上增减，不做过渡，下一帧就生效
+static void apply_hotkey(DimState *state, s32 delta) {
+    s32 brightness = state_brightness(state) + delta;
+    if (brightness < 0) brightness = 0;
+    if (brightness > DCLIGHT_BRIGHTNESS_MAX) brightness = DCLIGHT_BRIGHTNESS_MAX;
+    state->brightness = brightness;
+    state->alpha = config_brightness_to_alpha(brightness);
+    state->alpha8 = config_brightness_to_alpha8(brightness);
+    state->rampMs = 0;
+    state->fromIpc = true;
 }
 
-// 绘制基本原语
-static inline void setPixel(s32 x, s32 y, Color color) {
-    if (x < 0 || y < 0 || x >= (s32)CFG_FramebufferWidth || y >= (s32)CFG_FramebufferHeight || g_currentFramebuffer == NULL) return;
-    u32 offset = getPixelOffset(x, y);
-    ((u16*)g_currentFramebuffer)[offset] = color_to_u16(color);
+// 记下快捷键调节后的亮度，保存到给出当前亮度的那一节：当前应用的配置指定了亮度时是该应用的节，否则是 [DClight]；
+// 亮度由计划给出时不保存（全局 brightness 被计划覆盖，写进去也不会生效）。
+// 内存中的配置同时改成新值，切换应用或计划重新计算时不会退回调节前的亮度
+static void hotkey_remember(OverlayConfig *ini, OverlayConfig *active, u64 titleId, bool scheduleActive, s32 brightness) {
+    const TitleProfile *found = profile_lookup(&g_profiles, titleId);
+    if (found && (found->brightness >= 0 || found->alpha >= 0)) {
+        TitleProfile *profile = profile_table_upsert(&g_profiles, titleId);
+        profile->brightness = (s16)brightness;
+        g_hotkeySaveTitle = titleId;
+    } else if (scheduleActive) {
+        log_info("亮度由计划给出，快捷键调节不保存");
+        return;
+    } else {
+        ini->brightness = brightness;
+        g_hotkeySaveTitle = 0;
+    }
+    active->brightness = brightness;
+    // 连续调节时推迟保存，停下来之后只写一次
+    g_hotkeySaveValue = brightness;
+    sched_timer_cancel(SchedTimer_HotkeySave);
+    sched_timer_arm(SchedTimer_HotkeySave, HOTKEY_SAVE_DELAY_NS);
 }
 
-static inline void setPixelBlendDst(s32 x, s32 y, Color color) {
-    if (x < 0 || y < 0 || x >= (s32)CFG_FramebufferWidth || y >= (s32)CFG_FramebufferHeight || g_currentFramebuffer == NULL) return;
-    u32 offset = getPixelOffset(x, y);
-    Color src = color_from_u16(((u16*)g_currentFramebuffer)[offset]);
-    Color dst = color;
-    Color out = {0,0,0,0};
-    out.r = blendColor(src.r, dst.r, dst.a);
-    out.g = blendColor(src.g, dst.g, dst.a);
-    out.b = blendColor(src.b, dst.b, dst.a);
-    // alpha 叠加并限制到 0xF
-    u16 sumA = (u16)dst.a + (u16)src.a;
-    out.a = (sumA > 0xF) ? 0xF : (u8)sumA;
-    setPixel(x, y, out);
+// 写入快捷键调节后的亮度
+static void hotkey_persist(void) {
+    if (g_hotkeySaveValue < 0) return;
+    if (config_save_brightness(g_hotkeySaveTitle, g_hotkeySaveValue)) {
+        log_info("快捷键亮度 %d 已保存到 %s", g_hotkeySaveValue, g_hotkeySaveTitle != 0 ? "应用配置" : "[DClight]");
+    } else {
+        log_error("保存快捷键亮度失败");
+    }
+    g_hotkeySaveValue = -1;
 }
 
-static inline void drawRect(s32 x, s32 y, s32 w, s32 h, Color color) {
-    s32 x2 = x + w;
-    s32 y2 = y + h;
-    if (x2 < 0 || y2 < 0) return;
-    if (x >= (s32)CFG_FramebufferWidth || y >= (s32)CFG_FramebufferHeight) return;
-    if (x < 0) x = 0;
-    if (y < 0) y = 0;
-    if (x2 > (s32)CFG_FramebufferWidth) x2 = CFG_FramebufferWidth;
-    if (y2 > (s32)CFG_FramebufferHeight) y2 = CFG_FramebufferHeight;
-    for (s32 xi = x; xi < x2; ++xi) {
-        for (s32 yi = y; yi < y2; ++yi) {
-            setPixelBlendDst(xi, yi, color);
-        }
+// 应用共享内存信箱中 NRO 提交的控制字（过渡时长由 NRO 指定）
+static void apply_mailbox_control(DimState *state, const DClightMailboxControl *ctrl) {
+    if (ctrl->brightness >= 0) {
+        state->brightness = ctrl->brightness > DCLIGHT_BRIGHTNESS_MAX ? DCLIGHT_BRIGHTNESS_MAX : ctrl->brightness;
+        state->alpha = config_brightness_to_alpha(state->brightness);
+        state->alpha8 = config_brightness_to_alpha8(state->brightness);
+    } else {
+        state->brightness = DCLIGHT_BRIGHTNESS_NONE;
+        state->alpha = (u8)(ctrl->alpha > DCLIGHT_ALPHA_MAX ? DCLIGHT_ALPHA_MAX : ctrl->alpha);
+        state->alpha8 = config_alpha_to_alpha8(state->alpha);
+    }
+    state->rampMs = (u32)config_limit_ramp_ms(ctrl->ramp_ms);
+    state->fromIpc = true;
+}
+
+static void publish_status(const DimState *state) {
+    DClightStatus status = {
+        .api_version = DCLIGHT_IPC_API_VERSION,
+        .brightness = state->brightness,
+        .alpha = state->alpha,
+        .presented_alpha = g_presentedAlpha < 0 ? DCLIGHT_ALPHA_NONE : (u32)g_presentedAlpha,
+        .flags = (g_gfxInitialized ? DClightStatusFlag_GfxReady : 0) | (state->fromIpc ? DClightStatusFlag_FromIpc : 0)
+               | (g_backend == DimBackend_Cmu ? DClightStatusFlag_Cmu : 0),
+        .config_reloads = state->configReloads,
+    };
+    service_publish_status(&status);
+
+    DClightMailboxStatus mb = {
+        .brightness = status.brightness,
+        .alpha = status.alpha,
+        .presented_alpha = status.presented_alpha,
+        .flags = status.flags,
+    };
+    mailbox_publish(&mb);
+}
+
+// 绘制接口的 NWindow 帧缓冲实现
+static void *nx_framebuffer_begin(void *ctx) {
+    u64 start = armGetSystemTick();
+    void *pixels = framebufferBegin((Framebuffer *)ctx, NULL);
+    metrics_time(MetricTime_FbBegin, armGetSystemTick() - start);
+    return pixels;
+}
+
+static void nx_framebuffer_end(void *ctx, bool vsyncAligned) {
+    u64 start = armGetSystemTick();
+    if (!vsyncAligned) {
+        eventWait(&g_vsyncEvent, UINT64_MAX);
+        u64 now = armGetSystemTick();
+        metrics_time(MetricTime_VsyncWait, now - start);
+        start = now;
     }
+    framebufferEnd((Framebuffer *)ctx);
+    metrics_time(MetricTime_FbEnd, armGetSystemTick() - start);
 }
 
-static inline void fillScreen(Color color) {
-    drawRect(0, 0, CFG_FramebufferWidth, CFG_FramebufferHeight, color);
+static RenderFramebuffer g_renderFramebuffer = {
+    .ctx = &g_framebuffer,
+    .begin = nx_framebuffer_begin,
+    .end = nx_framebuffer_end,
+};
+
+// 当前的暗化掩码：没有掩码时不分配内存，帧缓冲为 1x1
+static DimMask g_mask;
+static DimMaskConfig g_maskConfig;
+
+// 仅在暗化等级变化时重绘并提交：画面不变时不出队/入队 NWindow 缓冲，也不等待 vsync，
+// 合成器会继续显示上一次提交的缓冲
+static void set_dim_backend(DimBackend backend);
+
+// 暗化是否按 0-255 的 alpha 绘制：CMU 的 luma 和 RGBA8888 帧缓冲上的均匀暗化；掩码和区域图层只有 16 级
+static bool dim_draws_alpha8(void) {
+    if (g_backend == DimBackend_Cmu) return true;
+    return !regions_active() && g_mask.delta == NULL && g_fbFormat == BlFormat_RGBA8888;
 }
 
-// 无混合的整屏填充（直接写入像素，保证底色和 alpha 精确）
-static inline void fillScreenSolid(Color color) {
-    if (g_currentFramebuffer == NULL) return;
-    for (s32 yi = 0; yi < (s32)CFG_FramebufferHeight; ++yi) {
-        for (s32 xi = 0; xi < (s32)CFG_FramebufferWidth; ++xi) {
-            setPixel(xi, yi, color);
+// alpha8 为同一时刻 0-255 的等级：CMU 和 RGBA8888 的均匀暗化用它画出比 16 级更细的过渡
+static void present_dim_alpha(u8 alpha, u8 alpha8, bool vsyncAligned) {
+    if (!g_gfxInitialized) return;
+    if (g_backend == DimBackend_Cmu) {
+        bool presented = cmu_backend_present(&g_cmu, alpha8);
+        if (cmu_backend_active(&g_cmu)) {
+            metrics_count(presented ? MetricCount_FramePresented : MetricCount_FrameSkipped);
+            return;
         }
+        log_error("CMU luma 设置失败，改用暗化图层");
+        set_dim_backend(DimBackend_Layer);
+    }
+    if (regions_active()) {
+        u32 presented = regions_present(alpha);
+        for (u32 i = 0; i < presented; ++i) metrics_count(MetricCount_FramePresented);
+        if (presented == 0) metrics_count(MetricCount_FrameSkipped);
+        return;
+    }
+    bool smooth = dim_draws_alpha8();
+    if (g_presentedAlpha == (s32)alpha && (!smooth || g_presentedAlpha8 == (s32)alpha8)) {
+        metrics_count(MetricCount_FrameSkipped);
+        return;
+    }
+
+    startFrame();
+    if (g_mask.delta) {
+        dim_mask_draw(&g_mask, alpha);
+    } else if (smooth) {
+        fillScreenSolid8((Color8){0, 0, 0, alpha8});
+    } else {
+        fillScreenSolid((Color){0, 0, 0, alpha});
+    }
+    endFrame(vsyncAligned);
+    g_presentedAlpha = alpha;
+    g_presentedAlpha8 = alpha8;
+    metrics_count(MetricCount_FramePresented);
+}
+
+static Result gfx_create_framebuffer(u16 width, u16 height) {
+    // 1x1 的帧按 DCLIGHT_FB_COUNT（精简模式单缓冲），掩码至少双缓冲（见 memstats.h）
+    bool wide = g_fbFormat == BlFormat_RGBA8888;
+    u32 count = width == 1 && height == 1 ? DCLIGHT_FB_COUNT : DCLIGHT_FB_COUNT_MASK;
+    log_debug("framebufferCreate(%u,%u,%s,%u)...", width, height, wide ? "RGBA_8888" : "RGBA_4444", count);
+    Result rc = framebufferCreate(&g_framebuffer, &g_window, width, height,
+                                  wide ? PIXEL_FORMAT_RGBA_8888 : PIXEL_FORMAT_RGBA_4444, count);
+    if (R_FAILED(rc)) return rc;
+    memstats_set_framebuffer(g_framebuffer.fb_size * g_framebuffer.num_fbs, g_framebuffer.num_fbs);
+
+    CFG_FramebufferWidth = width;
+    CFG_FramebufferHeight = height;
+    g_renderFramebuffer.width = width;
+    g_renderFramebuffer.height = height;
+    g_renderFramebuffer.stride = g_framebuffer.stride;
+    g_renderFramebuffer.format = g_fbFormat;
+    return 0;
+}
+
+// 改变帧缓冲尺寸或格式（图层尺寸不变，合成器按 FitToLayer 放大）；新尺寸失败时退回 1x1
+static Result gfx_resize_framebuffer(u16 width, u16 height) {
+    if (!g_gfxInitialized) return 0;
+    if (width == CFG_FramebufferWidth && height == CFG_FramebufferHeight && g_renderFramebuffer.format == g_fbFormat) return 0;
+
+    renderBind(NULL);
+    framebufferClose(&g_framebuffer);
+    memstats_set_framebuffer(0, 0);
+
+    Result rc = gfx_create_framebuffer(width, height);
+    if (R_FAILED(rc) && (width != 1 || height != 1)) {
+        log_error("framebufferCreate(%u,%u) 失败: 0x%x，退回 1x1", width, height, rc);
+        rc = gfx_create_framebuffer(1, 1);
+    }
+    if (R_FAILED(rc)) {
+        log_error("framebufferCreate 失败: 0x%x，停止绘制", rc);
+        g_gfxInitialized = false;
+        return rc;
+    }
+    renderBind(&g_renderFramebuffer);
+    g_presentedAlpha = -1;
+    return 0;
+}
+
+// 按区域列表增量更新区域图层；有区域时全屏图层退出合成，没有时恢复
+static void apply_regions(void) {
+    if (!g_gfxInitialized) return;
+    bool wasActive = regions_active();
+    regions_apply(&g_regions);
+    bool active = regions_active();
+    if (active && !wasActive) {
+        log_info("区域暗化: 隐藏全屏图层");
+        layer_hide(&g_layer);
+    } else if (!active && wasActive && g_backend == DimBackend_Layer) {
+        log_info("区域暗化结束: 恢复全屏图层");
+        layer_show(&g_layer);
+        g_presentedAlpha = -1;
     }
 }
 
-// 读取亮度(0-100)，映射为覆盖层alpha(0-15)，值越低越亮度越暗
-static u8 load_dim_alpha_from_ini(void) {
-    const char *ini_path = "sdmc:/config/DClight/config.ini";
-
-    // 允许键位于根或节 [DClight]/[overlay]
-    long brightness = ini_getl(NULL, "brightness", -1, ini_path);
-    if (brightness < 0) brightness = ini_getl("DClight", "brightness", -1, ini_path);
-    if (brightness < 0) brightness = ini_getl("overlay", "brightness", -1, ini_path);
-
-    long alpha_override = ini_getl(NULL, "alpha", -1, ini_path);
-    if (alpha_override < 0) alpha_override = ini_getl("DClight", "alpha", -1, ini_path);
-    if (alpha_override < 0) alpha_override = ini_getl("overlay", "alpha", -1, ini_path);
-
-    u8 alpha;
-    if (brightness >= 0) {
-        if (brightness < 0) brightness = 0;
-        if (brightness > 100) brightness = 100;
-        // 100 亮度 -> alpha=0（无暗化）；0 亮度 -> alpha=15（最暗）
-        alpha = (u8)(((100 - brightness) * 15) / 100);
-    } else if (alpha_override >= 0) {
-        if (alpha_override < 0) alpha_override = 0;
-        if (alpha_override > 15) alpha_override = 15;
-        alpha = (u8)alpha_override;
+// 切换暗化后端：CMU 生效时全屏图层退出合成，回到图层时重新加入并重绘
+static void set_dim_backend(DimBackend backend) {
+    if (backend == g_backend) return;
+    g_backend = backend;
+    if (regions_active()) return;
+    if (backend == DimBackend_Cmu) {
+        log_info("色彩管理暗化: 隐藏全屏图层");
+        layer_hide(&g_layer);
     } else {
-        // 默认：不暗化
-        alpha = 0;
+        log_info("恢复全屏暗化图层");
+        layer_show(&g_layer);
+        g_presentedAlpha = -1;
     }
+}
 
-    log_info("ini brightness=%ld, alpha_override=%ld -> alpha=%u (path=%s)", brightness, alpha_override, alpha, ini_path);
-    return alpha;
+// 按配置切换帧缓冲格式，尺寸不变
+static void apply_fb_format(BlFormat requested) {
+    if (requested == BlFormat_RGB565A) {
+        // 合成器按帧缓冲的 alpha 混合，RGB565 的图层会整个不透明地盖住画面
+        log_warning("fb_format=rgb565 没有 alpha，不能用于暗化图层，使用 rgba4444");
+        requested = BlFormat_RGBA4444;
+    }
+    if (requested == g_fbFormat) return;
+    log_info("帧缓冲格式: %s", requested == BlFormat_RGBA8888 ? "RGBA8888" : "RGBA4444");
+    g_fbFormat = requested;
+    gfx_resize_framebuffer(CFG_FramebufferWidth, CFG_FramebufferHeight);
 }
 
-// 帧控制
-static inline void startFrame(void) {
-    g_currentFramebuffer = framebufferBegin(&g_framebuffer, NULL);
+// 按配置选择暗化后端；区域和掩码只能由图层绘制，CMU 不可用或失败过时也使用图层
+static void apply_dim_backend(DimBackend requested) {
+    if (!g_gfxInitialized) return;
+    DimBackend backend = cmu_backend_select(&g_cmu, requested, regions_active() || g_mask.delta != NULL);
+    if (requested == DimBackend_Cmu && backend != DimBackend_Cmu) {
+        log_info("CMU 暗化不可用（%s），使用暗化图层", g_cmu.failed ? "命令失败" : "区域或掩码需要图层");
+    }
+    set_dim_backend(backend);
 }
 
-static inline void endFrame(void) {
-    eventWait(&g_vsyncEvent, UINT64_MAX);
-    framebufferEnd(&g_framebuffer);
-    g_currentFramebuffer = NULL;
+// 掩码参数变化时重新计算掩码并调整帧缓冲；只在配置变化时调用
+static void apply_dim_mask(const DimMaskConfig *cfg) {
+    bool active = dim_mask_active(cfg);
+    if (!active && !dim_mask_active(&g_maskConfig)) return;
+    if (memcmp(cfg, &g_maskConfig, sizeof(*cfg)) == 0) return;
+
+    dim_mask_free(&g_mask);
+    g_maskConfig = *cfg;
+    if (active && !dim_mask_build(&g_mask, cfg)) {
+        log_error("暗化掩码 %ux%u 内存不足，改为均匀暗化", cfg->width, cfg->height);
+        active = false;
+    }
+    gfx_resize_framebuffer(active ? (u16)cfg->width : 1, active ? (u16)cfg->height : 1);
+    if (active && g_gfxInitialized && (CFG_FramebufferWidth != cfg->width || CFG_FramebufferHeight != cfg->height)) {
+        // 帧缓冲退回了 1x1，掩码画不上去
+        log_error("暗化掩码 %ux%u 帧缓冲分配失败，改为均匀暗化", cfg->width, cfg->height);
+        dim_mask_free(&g_mask);
+        active = false;
+    }
+    if (active) log_info("暗化掩码: 形状 %d, %ux%u, strength=%d", cfg->shape, cfg->width, cfg->height, cfg->strength);
+    // 形状变化时即使 alpha 不变也要重绘
+    g_presentedAlpha = -1;
 }
 
 // 图形初始化与释放（移植 tesla Renderer::init/exit 的核心）
@@ -196,62 +481,47 @@ static Result gfx_init(void) {
     CFG_LayerPosX = 0;
     CFG_LayerPosY = 0;
 
-    log_info("viInitialize(ViServiceType_Manager)...");
+    log_debug("viInitialize(ViServiceType_Manager)...");
     Result rc = viInitialize(ViServiceType_Manager);
     if (R_FAILED(rc)) return rc;
+    boot_trace(DClightBootStep_ViInit);
 
-    log_info("viOpenDefaultDisplay...");
+    log_debug("viOpenDefaultDisplay...");
     rc = viOpenDefaultDisplay(&g_display);
     if (R_FAILED(rc)) return rc;
 
-    log_info("viGetDisplayVsyncEvent...");
+    log_debug("viGetDisplayVsyncEvent...");
     rc = viGetDisplayVsyncEvent(&g_display, &g_vsyncEvent);
     if (R_FAILED(rc)) return rc;
+    boot_trace(DClightBootStep_Display);
 
     // 确保显示全局 Alpha 为不透明
-    log_info("viSetDisplayAlpha(1.0f)...");
+    log_debug("viSetDisplayAlpha(1.0f)...");
     viSetDisplayAlpha(&g_display, 1.0f);
 
-    log_info("viCreateManagedLayer...");
-    rc = viCreateManagedLayer(&g_display, (ViLayerFlags)0, 0, &__nx_vi_layer_id);
-    if (R_FAILED(rc)) return rc;
-
-    log_info("viCreateLayer...");
-    rc = viCreateLayer(&g_display, &g_layer);
-    if (R_FAILED(rc)) return rc;
-
-    log_info("viSetLayerScalingMode(FitToLayer)...");
-    rc = viSetLayerScalingMode(&g_layer, ViScalingMode_FitToLayer);
-    if (R_FAILED(rc)) return rc;
-
-    s32 layerZ = 250;
-    log_info("viSetLayerZ(%d)...", layerZ);
-    rc = viSetLayerZ(&g_layer, layerZ);
-    if (R_FAILED(rc)) return rc;
-
-    // 保守策略：仅添加到必要的图层栈（Default + Screenshot）
-    log_info("viAddToLayerStack(Default and Screenshot)...");
-    rc = viAddToLayerStack(&g_layer, ViLayerStack_Default);
-    if (R_FAILED(rc)) return rc;
-    rc = viAddToLayerStack(&g_layer, ViLayerStack_Screenshot);
+    // 帧缓冲的格式和数量随配置变化，由 gfx_create_framebuffer 单独创建，这里只建图层
+    log_debug("layer_open(z=%d, %ux%u @ %u,%u)...", OVERLAY_LAYER_Z, CFG_LayerWidth, CFG_LayerHeight, CFG_LayerPosX, CFG_LayerPosY);
+    rc = layer_open(&g_display, &g_layer, OVERLAY_LAYER_Z, CFG_LayerPosX, CFG_LayerPosY, CFG_LayerWidth, CFG_LayerHeight);
     if (R_FAILED(rc)) return rc;
+    boot_trace(DClightBootStep_Layer);
 
-    log_info("viSetLayerSize(%u,%u)...", CFG_LayerWidth, CFG_LayerHeight);
-    rc = viSetLayerSize(&g_layer, CFG_LayerWidth, CFG_LayerHeight);
-    if (R_FAILED(rc)) return rc;
-    log_info("viSetLayerPosition(%u,%u) 屏幕居中", CFG_LayerPosX, CFG_LayerPosY);
-    rc = viSetLayerPosition(&g_layer, CFG_LayerPosX, CFG_LayerPosY);
-    if (R_FAILED(rc)) return rc;
-
-    log_info("nwindowCreateFromLayer...");
+    log_debug("nwindowCreateFromLayer...");
     rc = nwindowCreateFromLayer(&g_window, &g_layer);
     if (R_FAILED(rc)) return rc;
+    boot_trace(DClightBootStep_Window);
 
-    log_info("framebufferCreate(%u,%u,RGBA_4444,2)...", CFG_FramebufferWidth, CFG_FramebufferHeight);
-    rc = framebufferCreate(&g_framebuffer, &g_window, CFG_FramebufferWidth, CFG_FramebufferHeight, PIXEL_FORMAT_RGBA_4444, 2);
+    rc = gfx_create_framebuffer(CFG_FramebufferWidth, CFG_FramebufferHeight);
     if (R_FAILED(rc)) return rc;
+    renderBind(&g_renderFramebuffer);
+    regions_init(&g_display, OVERLAY_LAYER_Z);
+    osd_init(&g_display, OVERLAY_LAYER_Z + 1);
+    CmuOps cmuOps;
+    cmu_vi_ops(&g_display, &cmuOps);
+    cmu_backend_init(&g_cmu, &cmuOps);
+    boot_trace(DClightBootStep_Framebuffer);
 
     g_gfxInitialized = true;
+    g_presentedAlpha = -1;
     log_info("gfx_init 完成");
     return 0;
 }
@@ -261,8 +531,15 @@ static void gfx_exit(void) {
     
     log_info("开始清理图形资源...");
     
-    // 清理图形相关资源
+    // 清理图形相关资源；CMU 接管过的 luma 在关闭显示之前恢复
+    cmu_backend_release(&g_cmu);
+    g_backend = DimBackend_Layer;
+    osd_exit();
+    regions_exit();
+    renderBind(NULL);
     framebufferClose(&g_framebuffer);
+    memstats_set_framebuffer(0, 0);
+    dim_mask_free(&g_mask);
     nwindowClose(&g_window);
     
     // 安全清理VI资源，避免与其他 overlay 冲突（仿照 pop-windows-main）
@@ -310,6 +587,34 @@ void __libnx_initheap(void)
     extern void *fake_heap_end;
     fake_heap_start = inner_heap;
     fake_heap_end = inner_heap + sizeof(inner_heap);
+    memstats_init_heap(sizeof(inner_heap));
+    boot_trace(DClightBootStep_Heap);
+}
+
+// 第一帧用不到的基础服务：写日志线程（打开日志文件）、hid、time
+// 快速启动时由 main 在第一帧之后调用，否则在 __appInit 中调用
+static void app_init_late(void)
+{
+    // SD 卡可用后启动写日志线程，此前的消息已缓存在环形缓冲区中
+    log_init();
+    boot_trace(DClightBootStep_Log);
+
+    Result rc = hidInitialize();
+    if (R_FAILED(rc)) {
+        log_error("hidInitialize失败: 0x%x", rc);
+        fatalThrow(rc);
+    }
+    padInitializeAny(&g_pad);
+    hotkey_reset(&g_hotkey);
+    g_hidReady = true;
+    boot_trace(DClightBootStep_Hid);
+
+    // 本地时间：亮度计划和日志时间戳使用，失败时计划不生效
+    rc = timeInitialize();
+    if (R_FAILED(rc)) {
+        log_error("timeInitialize失败: 0x%x", rc);
+    }
+    boot_trace(DClightBootStep_Time);
 }
 
 // 必要服务初始化（完全仿照 pop-windows-main 的严格错误处理）
@@ -325,21 +630,21 @@ void __appInit(void)
         log_error("smInitialize失败: 0x%x", rc);
         fatalThrow(rc);
     }
+    boot_trace(DClightBootStep_Sm);
     
     rc = fsInitialize();
     if (R_FAILED(rc)) {
         log_error("fsInitialize失败: 0x%x", rc);
         fatalThrow(rc);
     }
+    boot_trace(DClightBootStep_Fs);
     
     fsdevMountSdmc();
+    boot_trace(DClightBootStep_SdMount);
     
-    // 其他服务初始化
-    rc = hidInitialize();
-    if (R_FAILED(rc)) {
-        log_error("hidInitialize失败: 0x%x", rc);
-        fatalThrow(rc);
-    }
+#if !DCLIGHT_FAST_START
+    app_init_late();
+#endif
     
     log_info("应用程序初始化完成");
 }
@@ -349,24 +654,118 @@ void __appExit(void)
 {
     log_info("应用程序退出开始...");
     
+    // 先停止 IPC 服务，不再接受调节请求
+    ipc_service_stop();
+    mailbox_exit();
+    title_monitor_exit();
+    power_psc_exit();
+
     // 优先清理图形资源，避免与其他叠加层冲突
     gfx_exit();
     
     // 清理其他服务
     hidExit();
     
+    log_info("应用程序退出完成");
+    // 卸载 SD 卡前写出剩余日志
+    log_exit();
+    timeExit();
+
     // 最后清理基础服务
     fsdevUnmountAll();
     fsExit();
     smExit();
-    
-    log_info("应用程序退出完成");
 }
 
 #ifdef __cplusplus
 }
 #endif
 
+// 应用监视是否可用（start_services 之后）
+static bool g_titleReady = false;
+// 进程事件已触发、正在等 TITLE_SETTLE_NS 后查询（此时事件不在等待集合中）
+static bool g_titleSettling = false;
+
+// 主机电源状态：睡眠期间主循环不设置任何定时器，也不绘制、不访问 SD 卡
+static PowerSource g_power;
+static PowerMonitor g_powerMonitor;
+
+static void apply_power_action(PowerAction action, void *arg) {
+    (void)arg;
+    if (action == PowerAction_Suspend) {
+        log_info("主机睡眠: 暂停主循环");
+        for (int i = 0; i < SchedTimer_Count; ++i) sched_timer_cancel((SchedTimerId)i);
+        sched_clear_waiter(SchedWaiter_Vsync);
+        sched_clear_waiter(SchedWaiter_Title);
+        g_titleSettling = false;
+        // 进行中的过渡直接到终点，醒来后不再补画中间的帧
+        ramp_set(&g_ramp, ramp_alpha(&g_ramp, ramp_end(&g_ramp)), ramp_alpha8(&g_ramp, ramp_end(&g_ramp)));
+        // 指示器的隐藏定时器已取消，直接收起
+        osd_hide();
+        // 确认之前写出待保存的亮度和日志，SD 卡在所有模块确认后才进入睡眠
+        hotkey_persist();
+        log_flush();
+    } else if (action == PowerAction_Resume) {
+        log_info("主机醒来: 重新提交暗化图层");
+        if (!g_gfxInitialized) return;
+        if (regions_active()) {
+            regions_resume();
+        } else if (g_backend == DimBackend_Cmu) {
+            cmu_backend_resume(&g_cmu);
+        } else {
+            Result rc = layer_show(&g_layer);
+            if (R_FAILED(rc)) log_debug("重新加入图层栈: 0x%x", rc);
+        }
+        g_presentedAlpha = -1;
+    }
+}
+
+// 第一帧用不到的服务：应用监视、共享内存信箱、IPC 服务（需先调用 sched_init）
+static void start_services(void)
+{
+    Result rc = title_monitor_init();
+    if (R_FAILED(rc)) {
+        log_error("应用监视初始化失败: 0x%x，忽略按应用的配置", rc);
+    }
+    g_titleReady = R_SUCCEEDED(rc);
+    boot_trace(DClightBootStep_Title);
+
+    rc = mailbox_init();
+    if (R_FAILED(rc)) {
+        log_error("共享内存信箱创建失败: 0x%x，仅使用 IPC 命令", rc);
+    }
+    Event *doorbell = mailbox_doorbell();
+    if (doorbell) {
+        sched_set_waiter(SchedWaiter_Mailbox, waiterForEvent(doorbell));
+    }
+    boot_trace(DClightBootStep_Mailbox);
+
+    power_monitor_init(&g_powerMonitor);
+    rc = power_psc_init(&g_power);
+    if (R_FAILED(rc)) {
+        log_error("电源状态模块注册失败: 0x%x，睡眠期间不会暂停", rc);
+    }
+    Event *powerEvent = power_psc_event();
+    if (powerEvent) {
+        sched_set_waiter(SchedWaiter_Power, waiterForEvent(powerEvent));
+    }
+
+    service_set_memory_source(memstats_read);
+    service_set_boot_trace_source(boot_trace_read);
+    service_set_metrics_source(metrics_read);
+    rc = ipc_service_start(&g_wakeEvent);
+    if (R_FAILED(rc)) {
+        log_error("IPC 服务启动失败: 0x%x，仅使用 config.ini", rc);
+    }
+    boot_trace(DClightBootStep_Ipc);
+
+    DClightMemoryStats mem;
+    memstats_read(&mem);
+    log_info("内存: 堆 %u/%u (峰值 %u), libnx 分配 %u 块 %u 字节, NV tmem %u, 帧缓冲 %u x%u",
+             mem.heap_used, mem.heap_size, mem.heap_peak, mem.libnx_live, mem.libnx_bytes,
+             mem.nv_tmem_size, mem.framebuffer_bytes, mem.framebuffer_count);
+}
+
 // 主入口：初始化绘制并执行一次演示帧，然后进入后台循环
 int main(int argc, char *argv[])
 {
@@ -379,16 +778,262 @@ int main(int argc, char *argv[])
         log_error("图形初始化失败: 0x%x", rc);
     }
 
-    // 后台循环：实时读取 INI 并调整覆盖层透明度
+    rc = config_watch_init();
+    bool watchReady = R_SUCCEEDED(rc);
+    if (!watchReady) {
+        log_error("配置监视初始化失败: 0x%x，退化为每次解析", rc);
+    }
+
+    ueventCreate(&g_wakeEvent, true);
+    sched_init();
+    sched_set_waiter(SchedWaiter_Wake, waiterForUEvent(&g_wakeEvent));
+
+    // 快速启动时第一轮循环只读全局配置并提交第一帧，之后才启动其余服务、解析完整配置
+    bool deferred = DCLIGHT_FAST_START;
+    bool reparse = false; // 第一帧之后强制重新读取完整配置
+    bool booted = false;
+    if (!deferred) start_services();
+
+    // 后台循环：没有事件时无限期休眠；IPC 请求、信箱 doorbell 和到期的定时器会唤醒它
+    DimState state = { .brightness = DCLIGHT_BRIGHTNESS_NONE };
+    ramp_set(&g_ramp, 0, 0);
+    u8 rampTarget = 0;
+    u8 rampTarget8 = 0;
+    u32 defaultRampMs = CONFIG_DEFAULT_RAMP_MS;
+    OverlayConfig iniConfig;       // 全局配置
+    OverlayConfig activeConfig;    // 叠加了当前应用配置后实际生效的配置
+    bool haveIniConfig = false;
+    bool scheduleActive = false;   // 当前亮度由 [schedule] 给出
+    u64 titleId = TITLE_ID_HOME_MENU;
+    profile_table_init(&g_profiles);
+    u32 events = SCHED_EVENT_TIMER(SchedTimer_ConfigPoll); // 首次迭代总是读取配置
     while (true) {
-        if (g_gfxInitialized) {
-            startFrame();
-            u8 dimAlpha = load_dim_alpha_from_ini();
-            fillScreenSolid((Color){0, 0, 0, dimAlpha});
-            endFrame();
+        if (events & SCHED_EVENT_WAITER(SchedWaiter_Power)) {
+            PowerAction action = power_dispatch(&g_powerMonitor, &g_power, apply_power_action, NULL);
+            if (action == PowerAction_Resume) {
+                // 睡眠期间配置、前台应用和本地时间都可能变化：像对应的定时器到期一样各检查一次
+                events |= SCHED_EVENT_TIMER(SchedTimer_ConfigPoll) | SCHED_EVENT_TIMER(SchedTimer_TitlePoll)
+                        | SCHED_EVENT_TIMER(SchedTimer_Schedule);
+            }
+        }
+        if (power_monitor_suspended(&g_powerMonitor)) {
+            // IPC 和信箱的请求留到醒来后再取（服务只保留最新的一个）
+            events = sched_wait();
+            continue;
+        }
+
+        if (events & SCHED_EVENT_TIMER(SchedTimer_TitlePoll)) g_titleSettling = false;
+        if (events & SCHED_EVENT_WAITER(SchedWaiter_Title)) {
+            // 进程事件由 am 复位：先移出等待集合，TITLE_SETTLE_NS 后再查询（见 title.h）
+            sched_clear_waiter(SchedWaiter_Title);
+            sched_timer_cancel(SchedTimer_TitlePoll);
+            sched_timer_arm(SchedTimer_TitlePoll, TITLE_SETTLE_NS);
+            g_titleSettling = true;
+        }
+
+        bool checkConfig = service_take_reload() || reparse
+            || (events & (SCHED_EVENT_TIMER(SchedTimer_ConfigPoll) | SCHED_EVENT_TIMER(SchedTimer_ConfigSettle)));
+
+        bool configChanged = false;
+        if (deferred) {
+            // 先取走文件时间戳，第一帧之后的完整解析就不会再被当作一次变化
+            config_watch_changed();
+            load_global_config(&iniConfig);
+            configChanged = true;
+            boot_trace(DClightBootStep_Config);
+        } else if ((checkConfig && config_watch_changed()) || reparse) {
+            load_config_from_ini(&iniConfig);
+            state.configReloads++;
+            configChanged = true;
+            apply_regions();
+            boot_trace(reparse ? DClightBootStep_FullConfig : DClightBootStep_Config);
+            reparse = false;
+        }
+
+        // 切换应用只在哈希表中查找，不重新读取配置
+        bool titleChanged = false;
+        if (g_titleReady && g_profiles.count > 0
+            && (configChanged || (events & SCHED_EVENT_TIMER(SchedTimer_TitlePoll)))) {
+            titleChanged = title_monitor_poll(&titleId);
+            if (titleChanged) log_info("前台应用切换: %016lx", titleId);
+        }
+
+        bool scheduleDue = (events & SCHED_EVENT_TIMER(SchedTimer_Schedule)) != 0;
+        if (configChanged || titleChanged || scheduleDue) {
+            // 计划只在到达下一次变化的时刻（或配置、应用变化）时计算，醒来后重新设置截止时间
+            u32 timeOfDay = 0;
+            bool useSchedule = g_schedule.count > 0 && local_time_of_day(&timeOfDay);
+            scheduleActive = useSchedule;
+
+            OverlayConfig cfg;
+            resolve_config(&iniConfig, titleId, useSchedule ? &timeOfDay : NULL, &cfg);
+            // 只有生效的配置真正变化才覆盖当前值，避免 IPC 实时预览被尚未写完的旧配置回滚
+            if (!haveIniConfig || memcmp(&cfg, &activeConfig, sizeof(cfg)) != 0) {
+                bool first = !haveIniConfig;
+                activeConfig = cfg;
+                haveIniConfig = true;
+                state.brightness = cfg.brightness >= 0 ? (s32)(cfg.brightness > 100 ? 100 : cfg.brightness) : DCLIGHT_BRIGHTNESS_NONE;
+                state.alpha = config_dim_alpha(&cfg);
+                state.alpha8 = config_dim_alpha8(&cfg);
+                state.fromIpc = false;
+                defaultRampMs = config_ramp_ms(&cfg);
+                state.rampMs = defaultRampMs;
+                log_info("生效配置: brightness=%ld, alpha=%u, ramp=%ums", cfg.brightness, state.alpha, defaultRampMs);
+                if (first) {
+                    // 启动时屏幕上还没有暗化画面，第一帧直接画到目标亮度，不从 0 过渡
+                    ramp_set(&g_ramp, state.alpha, state.alpha8);
+                    rampTarget = state.alpha;
+                    rampTarget8 = state.alpha8;
+                }
+
+                apply_fb_format(config_fb_format(&cfg));
+                DimMaskConfig maskConfig;
+                config_dim_mask(&cfg, &maskConfig);
+                apply_dim_mask(&maskConfig);
+                config_hotkey(&cfg, &g_hotkeyConfig);
+                g_indicatorMs = config_indicator_ms(&cfg);
+                if (g_indicatorMs == 0) osd_hide();
+            }
+            // 区域不在生效配置中，每次配置变化都重新选择
+            apply_dim_backend(config_dim_backend(&activeConfig));
+
+            // 下一次醒来按实际绘制的等级计算，因此放在帧缓冲格式、掩码和后端确定之后
+            sched_timer_cancel(SchedTimer_Schedule);
+            if (useSchedule) {
+                u64 waitNs = (u64)schedule_next_change(&g_schedule, timeOfDay, dim_draws_alpha8()) * 1000000000ULL;
+                if (waitNs != 0) sched_timer_arm(SchedTimer_Schedule, waitNs < SCHEDULE_MAX_SLEEP_NS ? waitNs : SCHEDULE_MAX_SLEEP_NS);
+            } else if (g_schedule.count > 0) {
+                sched_timer_arm(SchedTimer_Schedule, SCHEDULE_RETRY_NS);
+            }
+        }
+
+        // 快捷键或 IPC 改变了亮度（配置文件、计划和应用配置的变化不显示指示器）
+        bool userChange = false;
+        ServiceRequest req;
+        if (service_take_request(&req)) {
+            apply_service_request(&state, &req);
+            state.rampMs = defaultRampMs;
+            userChange = true;
+        }
+
+        DClightMailboxControl ctrl;
+        if (mailbox_poll(&ctrl)) {
+            apply_mailbox_control(&state, &ctrl);
+            userChange = true;
+        }
+
+        // 快捷键：修饰键未按住时按 hotkey_poll_ms 采样，按住后每个 vsync 采样一次
+        bool hotkeyEngaged = false;
+        if (g_hidReady && g_hotkeyConfig.modifiers != 0) {
+            padUpdate(&g_pad);
+            u64 buttons = padGetButtons(&g_pad);
+            s32 delta = hotkey_update(&g_hotkey, &g_hotkeyConfig, buttons, armTicksToNs(armGetSystemTick()));
+            hotkeyEngaged = hotkey_engaged(&g_hotkeyConfig, buttons);
+            if (delta != 0) {
+                apply_hotkey(&state, delta);
+                userChange = true;
+                log_info("快捷键: 亮度 %d", state.brightness);
+                hotkey_remember(&iniConfig, &activeConfig, titleId, scheduleActive, state.brightness);
+            }
+        }
+        if (events & SCHED_EVENT_TIMER(SchedTimer_HotkeySave)) {
+            hotkey_persist();
+        }
+
+        // 亮度指示器：每次改变都从头计时，到时后销毁图层
+        if (events & SCHED_EVENT_TIMER(SchedTimer_Indicator)) {
+            osd_hide();
+        }
+        if (userChange && g_indicatorMs > 0 && g_gfxInitialized && osd_show(state_brightness(&state))) {
+            sched_timer_cancel(SchedTimer_Indicator);
+            sched_timer_arm(SchedTimer_Indicator, (u64)g_indicatorMs * 1000000ULL);
+        }
+
+        // 目标变化时开始过渡；过渡期间每个 vsync 提交一次，结束后回到无事可做的空闲状态
+        u64 now = armGetSystemTick();
+        if (state.alpha != rampTarget || state.alpha8 != rampTarget8) {
+            ramp_start(&g_ramp, state.alpha, state.alpha8, now, armNsToTicks((u64)state.rampMs * 1000000ULL));
+            rampTarget = state.alpha;
+            rampTarget8 = state.alpha8;
+        }
+        present_dim_alpha(ramp_alpha(&g_ramp, now), ramp_alpha8(&g_ramp, now), (events & SCHED_EVENT_WAITER(SchedWaiter_Vsync)) != 0);
+        if (osd_present()) metrics_count(MetricCount_FramePresented);
+        publish_status(&state);
+        boot_trace(DClightBootStep_FirstFrame);
+
+        if (deferred) {
+            // 第一帧已提交：启动其余服务，并立即再跑一轮以解析完整配置
+            app_init_late();
+            start_services();
+            deferred = false;
+            reparse = true;
+            ueventSignal(&g_wakeEvent);
+        }
+
+        bool rampActive = ramp_active(&g_ramp, now);
+        if ((rampActive || hotkeyEngaged) && g_gfxInitialized) {
+            // vsync 事件不会自动清除，清除后等待的是下一个 vsync
+            eventClear(&g_vsyncEvent);
+            sched_set_waiter(SchedWaiter_Vsync, waiterForEvent(&g_vsyncEvent));
+        } else {
+            sched_clear_waiter(SchedWaiter_Vsync);
+        }
+        if (rampActive) {
+            // 屏幕关闭时可能收不到 vsync，到达终点时间时仍会醒来收尾
+            sched_timer_arm(SchedTimer_Transition, armTicksToNs(ramp_end(&g_ramp) - now));
+        } else {
+            sched_timer_cancel(SchedTimer_Transition);
+        }
+
+        if (checkConfig) {
+            // FAT 时间戳精度内可能还有未观察到的写入，稳定前继续检查
+            if (config_watch_settling()) {
+                sched_timer_arm(SchedTimer_ConfigSettle, CONFIG_SETTLE_POLL_NS);
+            }
+            // 配置了 config_poll_ms 时定期检查（兼容直接编辑 INI 而不通知服务的工具）；
+            // 无法读取文件时间戳时退化为原来的固定间隔
+            u64 pollNs = 0;
+            if (haveIniConfig && iniConfig.config_poll_ms > 0) {
+                pollNs = (u64)iniConfig.config_poll_ms * 1000000ULL;
+            } else if (!watchReady) {
+                pollNs = CONFIG_FALLBACK_POLL_NS;
+            }
+            if (pollNs != 0 && !sched_timer_armed(SchedTimer_ConfigPoll)) {
+                sched_timer_arm(SchedTimer_ConfigPoll, pollNs);
+            }
+        }
+
+        if (g_titleReady && g_profiles.count > 0) {
+            Event *processEvent = title_monitor_event();
+            if (processEvent && !g_titleSettling) sched_set_waiter(SchedWaiter_Title, waiterForEvent(processEvent));
+            if (!sched_timer_armed(SchedTimer_TitlePoll)) {
+                sched_timer_arm(SchedTimer_TitlePoll, processEvent ? TITLE_BACKSTOP_NS : TITLE_POLL_NS);
+            }
+        } else {
+            sched_timer_cancel(SchedTimer_TitlePoll);
+            sched_clear_waiter(SchedWaiter_Title);
+            g_titleSettling = false;
+        }
+
+        // 修饰键按住时由 vsync 唤醒，不需要定时器
+        if (g_hidReady && g_hotkeyConfig.modifiers != 0 && !(hotkeyEngaged && g_gfxInitialized)) {
+            u64 pollNs = hotkeyEngaged ? HOTKEY_ENGAGED_POLL_NS : (u64)g_hotkeyConfig.poll_ms * 1000000ULL;
+            if (!sched_timer_armed(SchedTimer_Hotkey)) sched_timer_arm(SchedTimer_Hotkey, pollNs);
+        } else {
+            sched_timer_cancel(SchedTimer_Hotkey);
+        }
+
+        if (!booted && !reparse) {
+            boot_trace(DClightBootStep_Ready);
+            boot_trace_log();
+            booted = true;
+        }
+
+        u64 waitStart = armGetSystemTick();
+        events = sched_wait();
+        if (events & SCHED_EVENT_WAITER(SchedWaiter_Vsync)) {
+            metrics_time(MetricTime_VsyncWait, armGetSystemTick() - waitStart);
         }
-        // 500ms 刷新一次亮度
-        svcSleepThread(500000000ULL);
     }
 
     gfx_exit();
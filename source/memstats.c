@@ -0,0 +1,75 @@
+// 内存统计
+// libnx 的 NV transfer memory、nvmap 缓冲（帧缓冲）和线程栈都经过 __libnx_alloc/__libnx_aligned_alloc/__libnx_free
+// 这几个弱符号分配，这里覆盖它们来计数；其余堆占用由 newlib 的 mallinfo 给出
+#include <malloc.h>
+#include <stdlib.h>
+#include "memstats.h"
+
+extern u32 __nx_nv_transfermem_size;
+
+_Static_assert(DCLIGHT_HEAP_SIZE >= DCLIGHT_HEAP_BUDGET, "DCLIGHT_HEAP_SIZE 小于 memstats.h 中的堆预算");
+
+static size_t g_heapSize = 0;
+
+static u32 g_libnxAllocs = 0;  // 累计分配次数
+static u32 g_libnxLive = 0;    // 尚未释放的块数
+static u32 g_libnxBytes = 0;   // 尚未释放的字节数
+static u32 g_libnxPeak = 0;
+static u32 g_fbBytes = 0;
+static u32 g_fbCount = 0;
+
+static void memstats_track_alloc(void *p) {
+    if (p == NULL) return;
+    u32 bytes = (u32)malloc_usable_size(p);
+    __atomic_add_fetch(&g_libnxAllocs, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_libnxLive, 1, __ATOMIC_RELAXED);
+    u32 now = __atomic_add_fetch(&g_libnxBytes, bytes, __ATOMIC_RELAXED);
+    u32 peak = __atomic_load_n(&g_libnxPeak, __ATOMIC_RELAXED);
+    while (now > peak && !__atomic_compare_exchange_n(&g_libnxPeak, &peak, now, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void *__libnx_alloc(size_t size) {
+    void *p = malloc(size);
+    memstats_track_alloc(p);
+    return p;
+}
+
+void *__libnx_aligned_alloc(size_t alignment, size_t size) {
+    // 与 libnx 默认实现一致：aligned_alloc 要求大小是对齐的整数倍
+    size = (size + alignment - 1) & ~(alignment - 1);
+    void *p = aligned_alloc(alignment, size);
+    memstats_track_alloc(p);
+    return p;
+}
+
+void __libnx_free(void *p) {
+    if (p == NULL) return;
+    __atomic_sub_fetch(&g_libnxLive, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&g_libnxBytes, (u32)malloc_usable_size(p), __ATOMIC_RELAXED);
+    free(p);
+}
+
+void memstats_init_heap(size_t size) {
+    g_heapSize = size;
+}
+
+void memstats_set_framebuffer(u32 bytes, u32 count) {
+    __atomic_store_n(&g_fbBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_fbCount, count, __ATOMIC_RELAXED);
+}
+
+void memstats_read(DClightMemoryStats *out) {
+    // arena 是 newlib 从 sbrk 取得的总量，malloc 不会把它还回去，因此就是堆的峰值占用
+    struct mallinfo mi = mallinfo();
+    out->heap_size = (u32)g_heapSize;
+    out->heap_used = (u32)mi.uordblks;
+    out->heap_peak = (u32)mi.arena;
+    out->libnx_allocs = __atomic_load_n(&g_libnxAllocs, __ATOMIC_RELAXED);
+    out->libnx_live = __atomic_load_n(&g_libnxLive, __ATOMIC_RELAXED);
+    out->libnx_bytes = __atomic_load_n(&g_libnxBytes, __ATOMIC_RELAXED);
+    out->libnx_peak = __atomic_load_n(&g_libnxPeak, __ATOMIC_RELAXED);
+    out->nv_tmem_size = __nx_nv_transfermem_size;
+    out->framebuffer_bytes = __atomic_load_n(&g_fbBytes, __ATOMIC_RELAXED);
+    out->framebuffer_count = __atomic_load_n(&g_fbCount, __ATOMIC_RELAXED);
+}
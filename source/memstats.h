@@ -0,0 +1,59 @@
+#pragma once
+
+// 内存预算与统计：堆（newlib malloc）、libnx 内部分配（NV transfer memory、帧缓冲、线程栈）、NV/帧缓冲占用
+#include <switch.h>
+#include <dclight/ipc.h>
+#include "gfx/mask.h"
+#include "gfx/indicator.h"
+
+// 精简模式（make LEAN=1）：1x1 帧单缓冲、按下面的预算给堆和 NV transfer memory
+// 默认值可在编译时用 -D 覆盖
+#ifdef DCLIGHT_LEAN
+#  ifndef DCLIGHT_HEAP_SIZE
+#    define DCLIGHT_HEAP_SIZE 0x68000
+#  endif
+#  ifndef DCLIGHT_NV_TMEM_SIZE
+#    define DCLIGHT_NV_TMEM_SIZE 0x40000
+#  endif
+#  ifndef DCLIGHT_FB_COUNT
+#    define DCLIGHT_FB_COUNT 1
+#  endif
+#else
+#  ifndef DCLIGHT_HEAP_SIZE
+#    define DCLIGHT_HEAP_SIZE 0xAF000
+#  endif
+#  ifndef DCLIGHT_NV_TMEM_SIZE
+#    define DCLIGHT_NV_TMEM_SIZE 0x64000
+#  endif
+#  ifndef DCLIGHT_FB_COUNT
+#    define DCLIGHT_FB_COUNT 2
+#  endif
+#endif
+
+// 帧缓冲占用：framebufferCreate 把每行按 64 字节、高度按 128 行对齐（块线性布局）
+#define DCLIGHT_FB_BYTES(w, h, bpp) ((((w) * (bpp) + 63) & ~63) * (((h) + 127) & ~127))
+
+// 多像素帧（掩码）的缓冲数：1x1 的帧只有一个像素，一次对齐写入不会被合成器读到一半，单缓冲在过渡中也不撕裂；
+// 掩码在过渡的每一步整帧重画，单缓冲时合成器可能读到半帧，至少要两个缓冲
+#define DCLIGHT_FB_COUNT_MASK (DCLIGHT_FB_COUNT > 2 ? DCLIGHT_FB_COUNT : 2)
+
+// 堆预算，按各处的分配大小计算（实机以 GetMemoryStats 的 heap_peak 为准）：
+//   NV transfer memory（nvInitialize 从堆上分配）   DCLIGHT_NV_TMEM_SIZE
+//   日志线程、IPC 线程的栈                          2 x 0x3000
+//   服务会话、newlib、应用配置表等常驻分配            约 0x4000
+//   默认尺寸的 RGBA4444 掩码：帧缓冲 + 增量和图像      2 x 0x4000 + 0x1B00（不用掩码时是 1x1 帧缓冲，更小）
+//   亮度指示器表面（显示期间）                       0x12000
+// 更大的掩码、RGBA8888 掩码和区域图层不计在内，分配失败时各自退回（均匀暗化、1x1、跳过该区域）
+#define DCLIGHT_HEAP_BUDGET                                                                     \
+    (DCLIGHT_NV_TMEM_SIZE + 2 * 0x3000 + 0x4000 +                                               \
+     DCLIGHT_FB_COUNT_MASK * DCLIGHT_FB_BYTES(DIM_MASK_DEFAULT_WIDTH, DIM_MASK_DEFAULT_HEIGHT, 2) + \
+     DIM_MASK_DEFAULT_WIDTH * DIM_MASK_DEFAULT_HEIGHT * 3 + DCLIGHT_FB_BYTES(INDICATOR_WIDTH, INDICATOR_HEIGHT, 2))
+
+// 在 __libnx_initheap 中登记内部堆的大小
+void memstats_init_heap(size_t size);
+
+// 登记帧缓冲占用（framebufferCreate 之后）；0 表示已释放
+void memstats_set_framebuffer(u32 bytes, u32 count);
+
+// 当前统计（可在任意线程调用）
+void memstats_read(DClightMemoryStats *out);
@@ -0,0 +1,99 @@
+// 运行时统计
+// 每分钟醒来次数按自然分钟窗口统计：当前窗口的计数在窗口结束后成为"最近一分钟"的值，
+// 读取时再按当前时间判断窗口是否已经过去，主循环长时间休眠时也能给出正确的值
+#include <string.h>
+#include "metrics.h"
+
+#define METRICS_MINUTE_NS (60ULL * 1000000000ULL)
+
+typedef struct {
+    u64 total_us;
+    u32 max_us;
+    u32 buckets[DCLIGHT_HISTOGRAM_BUCKETS];
+} MetricHistogram;
+
+static u32 g_counts[MetricCount_Count];
+static MetricHistogram g_times[MetricTime_Count];
+
+// 醒来次数的分钟窗口（只由主线程修改）
+static u64 g_minuteStart = 0; // 当前窗口的起点（系统 tick）
+static u32 g_minuteCount = 0; // 当前窗口内的醒来次数
+static u32 g_lastMinute = 0;  // 上一个窗口的醒来次数
+
+static u32 histogram_bucket(u32 us) {
+    if (us < 64) return 0;
+    u32 bucket = (31 - (u32)__builtin_clz(us) - 6) / 2 + 1;
+    return bucket < DCLIGHT_HISTOGRAM_BUCKETS ? bucket : DCLIGHT_HISTOGRAM_BUCKETS - 1;
+}
+
+static void metrics_wakeup(void) {
+    u64 now = armGetSystemTick();
+    u64 minute = armNsToTicks(METRICS_MINUTE_NS);
+    u64 start = __atomic_load_n(&g_minuteStart, __ATOMIC_RELAXED);
+    if (start == 0 || now - start >= minute) {
+        // 跨过了不止一个窗口时，上一个完整的一分钟内没有醒来
+        u32 last = start != 0 && now - start < 2 * minute ? g_minuteCount : 0;
+        __atomic_store_n(&g_lastMinute, last, __ATOMIC_RELAXED);
+        __atomic_store_n(&g_minuteCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&g_minuteStart, start == 0 ? now : start + (now - start) / minute * minute, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&g_minuteCount, 1, __ATOMIC_RELAXED);
+}
+
+void metrics_count(MetricCount id) {
+    __atomic_add_fetch(&g_counts[id], 1, __ATOMIC_RELAXED);
+    if (id == MetricCount_Wakeup) metrics_wakeup();
+}
+
+void metrics_time(MetricTime id, u64 ticks) {
+    MetricHistogram *h = &g_times[id];
+    u64 us64 = armTicksToNs(ticks) / 1000ULL;
+    u32 us = us64 > UINT32_MAX ? UINT32_MAX : (u32)us64;
+
+    __atomic_add_fetch(&h->total_us, us, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->buckets[histogram_bucket(us)], 1, __ATOMIC_RELAXED);
+    u32 max = __atomic_load_n(&h->max_us, __ATOMIC_RELAXED);
+    while (us > max && !__atomic_compare_exchange_n(&h->max_us, &max, us, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void histogram_read(const MetricHistogram *h, DClightHistogram *out) {
+    out->total_us = __atomic_load_n(&h->total_us, __ATOMIC_RELAXED);
+    out->max_us = __atomic_load_n(&h->max_us, __ATOMIC_RELAXED);
+    for (u32 i = 0; i < DCLIGHT_HISTOGRAM_BUCKETS; ++i) {
+        out->buckets[i] = __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED);
+    }
+}
+
+static u32 metrics_load(MetricCount id) {
+    return __atomic_load_n(&g_counts[id], __ATOMIC_RELAXED);
+}
+
+void metrics_read(DClightMetrics *out) {
+    memset(out, 0, sizeof(*out));
+    u64 now = armGetSystemTick();
+    out->uptime_s = (u32)(armTicksToNs(now) / 1000000000ULL);
+
+    // 窗口由主线程在醒来时推进；主线程休眠期间已经过去的窗口在这里补算
+    u64 minute = armNsToTicks(METRICS_MINUTE_NS);
+    u64 start = __atomic_load_n(&g_minuteStart, __ATOMIC_RELAXED);
+    if (start == 0 || now - start >= 2 * minute) {
+        out->wakeups_per_minute = 0;
+    } else if (now - start >= minute) {
+        out->wakeups_per_minute = __atomic_load_n(&g_minuteCount, __ATOMIC_RELAXED);
+    } else {
+        out->wakeups_per_minute = __atomic_load_n(&g_lastMinute, __ATOMIC_RELAXED);
+    }
+
+    out->wakeups = metrics_load(MetricCount_Wakeup);
+    out->frames_presented = metrics_load(MetricCount_FramePresented);
+    out->frames_skipped = metrics_load(MetricCount_FrameSkipped);
+    out->config_checks = metrics_load(MetricCount_ConfigCheck);
+    out->config_reads = metrics_load(MetricCount_ConfigRead);
+    out->log_writes = metrics_load(MetricCount_LogWrite);
+    out->title_polls = metrics_load(MetricCount_TitlePoll);
+    histogram_read(&g_times[MetricTime_ConfigReload], &out->config_reload);
+    histogram_read(&g_times[MetricTime_VsyncWait], &out->vsync_wait);
+    histogram_read(&g_times[MetricTime_FbBegin], &out->fb_begin);
+    histogram_read(&g_times[MetricTime_FbEnd], &out->fb_end);
+}
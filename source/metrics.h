@@ -0,0 +1,33 @@
+#pragma once
+
+// 运行时统计：主循环和绘制路径上的计数与耗时直方图，通过 GetMetrics 命令读取
+// 记录只是几次原子加法（不加锁、不分配内存），可以留在每一帧的路径上
+#include <switch.h>
+#include <dclight/ipc.h>
+
+typedef enum {
+    MetricCount_Wakeup,
+    MetricCount_FramePresented,
+    MetricCount_FrameSkipped,
+    MetricCount_ConfigCheck,
+    MetricCount_ConfigRead,
+    MetricCount_LogWrite,
+    MetricCount_TitlePoll,
+    MetricCount_Count,
+} MetricCount;
+
+typedef enum {
+    MetricTime_ConfigReload,
+    MetricTime_VsyncWait,
+    MetricTime_FbBegin,
+    MetricTime_FbEnd,
+    MetricTime_Count,
+} MetricTime;
+
+void metrics_count(MetricCount id);
+
+// 记录一次耗时（系统 tick）
+void metrics_time(MetricTime id, u64 ticks);
+
+// 当前统计（可在任意线程调用；各字段分别读取，彼此之间不保证是同一时刻的值）
+void metrics_read(DClightMetrics *out);
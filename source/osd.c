@@ -0,0 +1,72 @@
+// 亮度指示器图层
+#include "osd.h"
+#include "layer.h"
+#include "metrics.h"
+#include "gfx/indicator.h"
+#include "util/log.h"
+
+// 距屏幕右上角的边距（屏幕坐标）
+#define OSD_MARGIN   32
+
+static ViDisplay *g_display = NULL;
+static s32 g_layerZ = 0;
+static bool g_created = false;
+static ViLayer g_layer;
+static NWindow g_window;
+static Framebuffer g_fb;
+static IndicatorView g_view;
+static s32 g_value = 0;
+
+void osd_init(ViDisplay *display, s32 z) {
+    g_display = display;
+    g_layerZ = z;
+}
+
+void osd_exit(void) {
+    osd_hide();
+    g_display = NULL;
+}
+
+bool osd_show(s32 brightness) {
+    if (g_display == NULL) return false;
+    if (!g_created) {
+        // 帧缓冲与图层同尺寸（1:1，点阵字不被缩放模糊），单缓冲保留上一帧，之后只重画变化的部分
+        Result rc = layer_create(g_display, &g_layer, &g_window, &g_fb, g_layerZ,
+                                 SCREEN_WIDTH - OSD_MARGIN - INDICATOR_WIDTH, OSD_MARGIN, INDICATOR_WIDTH, INDICATOR_HEIGHT,
+                                 INDICATOR_WIDTH, INDICATOR_HEIGHT);
+        if (R_FAILED(rc)) {
+            log_error("亮度指示器: 创建图层失败: 0x%x", rc);
+            return false;
+        }
+        g_created = true;
+        indicator_invalidate(&g_view);
+    }
+    g_value = brightness < 0 ? 0 : (brightness > 100 ? 100 : brightness);
+    return true;
+}
+
+bool osd_present(void) {
+    if (!g_created || !indicator_dirty(&g_view, g_value)) return false;
+    u64 start = armGetSystemTick();
+    void *pixels = framebufferBegin(&g_fb, NULL);
+    u64 dequeued = armGetSystemTick();
+    metrics_time(MetricTime_FbBegin, dequeued - start);
+    if (pixels == NULL) return false;
+    BlSurface surface = { pixels, INDICATOR_WIDTH, INDICATOR_HEIGHT, g_fb.stride, BlFormat_RGBA4444 };
+    IndicatorDamage damage = indicator_draw(&g_view, &surface, g_value);
+    u64 drawn = armGetSystemTick();
+    framebufferEnd(&g_fb);
+    metrics_time(MetricTime_FbEnd, armGetSystemTick() - drawn);
+    log_debug("亮度指示器: %d，重画 %u 个像素", g_value, damage.pixels);
+    return true;
+}
+
+void osd_hide(void) {
+    if (!g_created) return;
+    layer_destroy(&g_layer, &g_window, &g_fb);
+    g_created = false;
+}
+
+bool osd_visible(void) {
+    return g_created;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+// 亮度指示器图层：亮度被快捷键或 IPC 改变时在屏幕右上角显示一小段时间，画面由 gfx/indicator.c 绘制
+// 图层和帧缓冲只在显示期间存在，隐藏时全部释放，不常驻占用堆
+#include <switch.h>
+
+void osd_init(ViDisplay *display, s32 z);
+void osd_exit(void);
+
+// 显示 brightness（0-100），没有图层时创建；失败返回 false
+bool osd_show(s32 brightness);
+
+// 把待显示的值画到图层上，只重画变化的部分；返回是否提交了新的一帧
+bool osd_present(void);
+
+// 销毁图层，释放帧缓冲
+void osd_hide(void);
+
+bool osd_visible(void);
@@ -0,0 +1,41 @@
+// 主机电源状态
+// 确认必须在动作完成之后：挂起时日志要在 SD 卡进入睡眠前写完
+#include <stddef.h>
+#include "power.h"
+
+void power_monitor_init(PowerMonitor *pm) {
+    pm->suspended = false;
+    pm->shutdown = false;
+    pm->sleeps = 0;
+}
+
+PowerAction power_monitor_update(PowerMonitor *pm, PowerEvent event) {
+    switch (event) {
+        case PowerEvent_Sleep:
+            if (pm->suspended) return PowerAction_None;
+            pm->suspended = true;
+            pm->sleeps++;
+            return PowerAction_Suspend;
+        case PowerEvent_Wake:
+            if (!pm->suspended || pm->shutdown) return PowerAction_None;
+            pm->suspended = false;
+            return PowerAction_Resume;
+        case PowerEvent_Shutdown:
+            pm->shutdown = true;
+            if (pm->suspended) return PowerAction_None;
+            pm->suspended = true;
+            return PowerAction_Suspend;
+        default:
+            return PowerAction_None;
+    }
+}
+
+PowerAction power_dispatch(PowerMonitor *pm, const PowerSource *source,
+                           void (*apply)(PowerAction action, void *arg), void *arg) {
+    PowerEvent event;
+    if (source->take == NULL || !source->take(source->ctx, &event)) return PowerAction_None;
+    PowerAction action = power_monitor_update(pm, event);
+    if (action != PowerAction_None && apply != NULL) apply(action, arg);
+    if (source->ack) source->ack(source->ctx);
+    return action;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// 主机睡眠时挂起主循环：睡眠前取消所有定时器、停止绘制和 SD 卡访问，醒来后重新确认图层并提交一次
+// 事件来源抽象为 PowerSource：sysmodule 中是 PSC 电源状态模块（power_psc.c），宿主测试中是脚本
+// （与平台无关：sysmodule 和宿主工具共用）
+#include <switch/types.h>
+
+typedef enum {
+    PowerEvent_None,     // 不需要处理的中间状态（只需确认）
+    PowerEvent_Sleep,    // 即将睡眠
+    PowerEvent_Wake,     // 已经醒来（或取消了睡眠）
+    PowerEvent_Shutdown, // 即将关机或重启
+} PowerEvent;
+
+typedef enum {
+    PowerAction_None,
+    PowerAction_Suspend, // 停止定时器和 I/O，写出日志
+    PowerAction_Resume,  // 重新确认图层、重新提交一帧，按当前时间重新计算各定时器
+} PowerAction;
+
+typedef struct {
+    void *ctx;
+    // 取走当前的电源状态变化（每次事件触发后调用一次）；没有可读的请求时返回 false
+    bool (*take)(void *ctx, PowerEvent *out);
+    // 确认已经处理完 take 给出的状态变化；系统在所有模块确认后才继续进入该状态
+    void (*ack)(void *ctx);
+} PowerSource;
+
+typedef struct {
+    bool suspended;
+    bool shutdown; // 关机前挂起后不再恢复
+    u32 sleeps;    // 进入睡眠的次数
+} PowerMonitor;
+
+void power_monitor_init(PowerMonitor *pm);
+
+// 按事件更新状态并给出主循环要做的动作；重复的事件（如连续两次睡眠通知）不产生动作
+PowerAction power_monitor_update(PowerMonitor *pm, PowerEvent event);
+
+static inline bool power_monitor_suspended(const PowerMonitor *pm) {
+    return pm->suspended;
+}
+
+// 从 source 取走一个事件并更新状态，调用 apply 执行动作后确认；没有事件时返回 PowerAction_None
+PowerAction power_dispatch(PowerMonitor *pm, const PowerSource *source,
+                           void (*apply)(PowerAction action, void *arg), void *arg);
@@ -0,0 +1,67 @@
+// PSC 电源状态模块
+// 依赖 fs：睡眠时在 SD 卡之前收到通知，写出日志后才确认
+#include "power_psc.h"
+
+// 自定义的模块编号，不与系统模块冲突
+#define POWER_PSC_MODULE_ID ((PscPmModuleId)0xDC)
+
+static PscPmModule g_module;
+static PscPmState g_state = PscPmState_Awake;
+static bool g_ready = false;
+
+static bool power_psc_take(void *ctx, PowerEvent *out) {
+    (void)ctx;
+    u32 flags = 0;
+    if (R_FAILED(pscPmModuleGetRequest(&g_module, &g_state, &flags))) return false;
+    switch (g_state) {
+        case PscPmState_ReadySleep:
+        case PscPmState_ReadySleepCritical:
+            *out = PowerEvent_Sleep;
+            break;
+        case PscPmState_Awake:
+            // ReadyAwaken 时显示还没有恢复，等到 Awake 再重新提交
+            *out = PowerEvent_Wake;
+            break;
+        case PscPmState_ReadyShutdown:
+            *out = PowerEvent_Shutdown;
+            break;
+        default:
+            *out = PowerEvent_None;
+            break;
+    }
+    return true;
+}
+
+static void power_psc_ack(void *ctx) {
+    (void)ctx;
+    pscPmModuleAcknowledge(&g_module, g_state);
+}
+
+Result power_psc_init(PowerSource *out) {
+    Result rc = pscmInitialize();
+    if (R_FAILED(rc)) return rc;
+
+    static const u32 dependencies[] = { PscPmModuleId_Fs };
+    rc = pscmGetPmModule(&g_module, POWER_PSC_MODULE_ID, dependencies, sizeof(dependencies) / sizeof(dependencies[0]), true);
+    if (R_FAILED(rc)) {
+        pscmExit();
+        return rc;
+    }
+    g_ready = true;
+    out->ctx = NULL;
+    out->take = power_psc_take;
+    out->ack = power_psc_ack;
+    return 0;
+}
+
+void power_psc_exit(void) {
+    if (!g_ready) return;
+    pscPmModuleFinalize(&g_module);
+    pscPmModuleClose(&g_module);
+    pscmExit();
+    g_ready = false;
+}
+
+Event *power_psc_event(void) {
+    return g_ready ? &g_module.event : NULL;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// PSC 电源状态模块：作为 PowerSource 提供睡眠、醒来和关机通知
+#include <switch.h>
+#include "power.h"
+
+Result power_psc_init(PowerSource *out);
+void power_psc_exit(void);
+
+// 有新的状态请求时触发（自动清除）；未初始化时返回 NULL
+Event *power_psc_event(void);
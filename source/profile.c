@@ -0,0 +1,99 @@
+// 按应用的亮度配置表
+// title ID 的低 12 位通常为 0（更新/DLC 使用这些位），直接取低位会全部冲突，
+// 因此用乘法哈希取高位；线性探测，装载因子不超过 1/2
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "profile.h"
+
+#define PROFILE_MIN_SLOTS 16
+
+static inline u32 profile_hash(u64 title_id, u32 mask) {
+    return (u32)((title_id * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+void profile_table_init(ProfileTable *table) {
+    table->slots = NULL;
+    table->mask = 0;
+    table->count = 0;
+}
+
+void profile_table_free(ProfileTable *table) {
+    free(table->slots);
+    profile_table_init(table);
+}
+
+bool profile_parse_section(const char *section, u64 *out_title_id) {
+    size_t prefix = sizeof(PROFILE_SECTION_PREFIX) - 1;
+    if (strncasecmp(section, PROFILE_SECTION_PREFIX, prefix) != 0) return false;
+
+    const char *p = section + prefix;
+    if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) p += 2;
+
+    u64 id = 0;
+    int digits = 0;
+    for (; *p; ++p, ++digits) {
+        int v;
+        if (*p >= '0' && *p <= '9') v = *p - '0';
+        else if (*p >= 'a' && *p <= 'f') v = *p - 'a' + 10;
+        else if (*p >= 'A' && *p <= 'F') v = *p - 'A' + 10;
+        else return false;
+        if (digits >= 16) return false;
+        id = (id << 4) | (u64)v;
+    }
+    if (digits == 0 || id == 0) return false;
+
+    *out_title_id = id;
+    return true;
+}
+
+static TitleProfile *profile_find_slot(TitleProfile *slots, u32 mask, u64 title_id) {
+    u32 i = profile_hash(title_id, mask);
+    while (slots[i].title_id != 0 && slots[i].title_id != title_id) {
+        i = (i + 1) & mask;
+    }
+    return &slots[i];
+}
+
+static bool profile_table_grow(ProfileTable *table) {
+    u32 capacity = table->slots ? (table->mask + 1) * 2 : PROFILE_MIN_SLOTS;
+    TitleProfile *slots = calloc(capacity, sizeof(TitleProfile));
+    if (slots == NULL) return false;
+
+    u32 mask = capacity - 1;
+    if (table->slots) {
+        for (u32 i = 0; i <= table->mask; ++i) {
+            if (table->slots[i].title_id == 0) continue;
+            *profile_find_slot(slots, mask, table->slots[i].title_id) = table->slots[i];
+        }
+        free(table->slots);
+    }
+    table->slots = slots;
+    table->mask = mask;
+    return true;
+}
+
+TitleProfile *profile_table_upsert(ProfileTable *table, u64 title_id) {
+    if (title_id == 0) return NULL;
+    if (table->slots) {
+        TitleProfile *slot = profile_find_slot(table->slots, table->mask, title_id);
+        if (slot->title_id == title_id) return slot;
+    }
+
+    if (table->slots == NULL || (table->count + 1) * 2 > table->mask + 1) {
+        if (!profile_table_grow(table)) return NULL;
+    }
+    TitleProfile *slot = profile_find_slot(table->slots, table->mask, title_id);
+    slot->title_id = title_id;
+    slot->brightness = -1;
+    slot->alpha = -1;
+    slot->ramp_ms = -1;
+    table->count++;
+    return slot;
+}
+
+const TitleProfile *profile_lookup(const ProfileTable *table, u64 title_id) {
+    if (table->count == 0 || title_id == 0) return NULL;
+    const TitleProfile *slot = profile_find_slot(table->slots, table->mask, title_id);
+    return slot->title_id == title_id ? slot : NULL;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// 按应用的亮度配置：config.ini 中的 [title_<16 位十六进制 title ID>] 节，
+// 例如 [title_0100000000001000] 对应主菜单
+// 配置变化时整体重建为开放寻址哈希表，切换应用时 O(1) 查找，不访问 SD 卡
+// （与平台无关：sysmodule 和宿主基准工具共用）
+#include <switch/types.h>
+
+// 没有运行应用时视为主菜单（qlaunch）
+#define TITLE_ID_HOME_MENU 0x0100000000001000ULL
+
+#define PROFILE_SECTION_PREFIX "title_"
+
+// 一个应用的配置；未设置的字段为 -1
+typedef struct {
+    u64 title_id;   // 0 表示空槽
+    s16 brightness; // 0-100，优先于 alpha
+    s16 alpha;      // 0-15
+    s32 ramp_ms;
+} TitleProfile;
+
+typedef struct {
+    TitleProfile *slots;
+    u32 mask;  // 槽数 - 1（槽数为 2 的幂），slots 为 NULL 时无意义
+    u32 count;
+} ProfileTable;
+
+void profile_table_init(ProfileTable *table);
+void profile_table_free(ProfileTable *table);
+
+// 解析节名 "title_<hex>"；不是应用节时返回 false
+bool profile_parse_section(const char *section, u64 *out_title_id);
+
+// 取得 title_id 的配置，不存在时插入一个所有字段为 -1 的新项；内存不足时返回 NULL
+TitleProfile *profile_table_upsert(ProfileTable *table, u64 title_id);
+
+// 查找 title_id 的配置，没有时返回 NULL
+const TitleProfile *profile_lookup(const ProfileTable *table, u64 title_id);
@@ -0,0 +1,54 @@
+// 暗化 alpha 的线性过渡
+#include "ramp.h"
+
+static s32 ramp_lerp(const DimRamp *ramp, s32 from, s32 to, u64 now) {
+    if (ramp->duration == 0 || now >= ramp->start + ramp->duration) return to;
+    if (now <= ramp->start) return from;
+    u64 elapsed = now - ramp->start;
+    s64 delta = (s64)(to - from);
+    return from + (s32)(delta * (s64)elapsed / (s64)ramp->duration);
+}
+
+static u8 ramp_round(s32 value) {
+    return (u8)((value + (1 << (RAMP_FRAC_BITS - 1))) >> RAMP_FRAC_BITS);
+}
+
+void ramp_set(DimRamp *ramp, u8 alpha, u8 alpha8) {
+    ramp->from = ramp->to = (s32)alpha << RAMP_FRAC_BITS;
+    ramp->from8 = ramp->to8 = (s32)alpha8 << RAMP_FRAC_BITS;
+    ramp->start = 0;
+    ramp->duration = 0;
+}
+
+void ramp_start(DimRamp *ramp, u8 target, u8 target8, u64 now, u64 duration) {
+    s32 current = ramp_lerp(ramp, ramp->from, ramp->to, now);
+    s32 current8 = ramp_lerp(ramp, ramp->from8, ramp->to8, now);
+    s32 to = (s32)target << RAMP_FRAC_BITS;
+    s32 to8 = (s32)target8 << RAMP_FRAC_BITS;
+    if (duration == 0 || (current == to && current8 == to8)) {
+        ramp->from = ramp->to = to;
+        ramp->from8 = ramp->to8 = to8;
+        ramp->start = now;
+        ramp->duration = 0;
+        return;
+    }
+    // 过渡途中改变目标时从当前插值位置继续，不会跳回整数等级
+    ramp->from = current;
+    ramp->to = to;
+    ramp->from8 = current8;
+    ramp->to8 = to8;
+    ramp->start = now;
+    ramp->duration = duration;
+}
+
+u8 ramp_alpha(const DimRamp *ramp, u64 now) {
+    return ramp_round(ramp_lerp(ramp, ramp->from, ramp->to, now));
+}
+
+u8 ramp_alpha8(const DimRamp *ramp, u64 now) {
+    return ramp_round(ramp_lerp(ramp, ramp->from8, ramp->to8, now));
+}
+
+bool ramp_active(const DimRamp *ramp, u64 now) {
+    return ramp->duration != 0 && now < ramp->start + ramp->duration;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// 暗化 alpha 的线性过渡：以 1/256 为精度插值，同时给出 0-15 的 alpha 和 0-255 的 alpha。
+// 两者各有自己的目标（亮度换算到 0-255 时不一定落在 16 级上），在同一段时间内一起插值
+// 只做纯计算，时间由调用者以系统 tick 传入
+#include <switch/types.h>
+
+#define RAMP_FRAC_BITS 8
+
+typedef struct {
+    s32 from;      // 0-15 alpha 的起点（定点，RAMP_FRAC_BITS 位小数）
+    s32 to;        // 0-15 alpha 的终点（定点）
+    s32 from8;     // 0-255 alpha 的起点（定点）
+    s32 to8;       // 0-255 alpha 的终点（定点）
+    u64 start;     // 开始 tick
+    u64 duration;  // 时长 tick，0 表示已经到达终点
+} DimRamp;
+
+// 立即跳到 alpha（0-15）和 alpha8（0-255），不做过渡
+void ramp_set(DimRamp *ramp, u8 alpha, u8 alpha8);
+
+// 从当前插值位置开始向 target（0-15）和 target8（0-255）过渡；duration 为 0 时等同 ramp_set
+void ramp_start(DimRamp *ramp, u8 target, u8 target8, u64 now, u64 duration);
+
+// now 时刻的 alpha（0-15）
+u8 ramp_alpha(const DimRamp *ramp, u64 now);
+
+// now 时刻的 alpha（0-255，8 位 alpha 的帧缓冲用它画出更细的过渡和终点）
+u8 ramp_alpha8(const DimRamp *ramp, u64 now);
+
+// now 时刻过渡是否仍在进行
+bool ramp_active(const DimRamp *ramp, u64 now);
+
+// 过渡结束的 tick
+static inline u64 ramp_end(const DimRamp *ramp) {
+    return ramp->start + ramp->duration;
+}
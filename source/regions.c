@@ -0,0 +1,151 @@
+// 区域暗化图层
+#include <stdlib.h>
+#include <string.h>
+#include <dclight/ipc.h>
+#include "regions.h"
+#include "layer.h"
+#include "util/log.h"
+
+typedef struct {
+    DimRegion region;
+    DimLayer layer;
+    bool used;
+} RegionSlot;
+
+static ViDisplay *g_display = NULL;
+static s32 g_layerZ = 0;
+static RegionSlot g_slots[DIM_REGION_MAX];
+static u32 g_active = 0;
+
+static bool parse_int(const char **p, s32 *out) {
+    char *end;
+    long v = strtol(*p, &end, 10);
+    if (end == *p) return false;
+    *out = (s32)v;
+    *p = end;
+    while (**p == ' ' || **p == '\t') ++*p;
+    if (**p == ',') ++*p;
+    return true;
+}
+
+bool dim_region_parse(const char *name, const char *value, DimRegion *out) {
+    memset(out, 0, sizeof(*out));
+    strncpy(out->name, name, DIM_REGION_NAME_MAX - 1);
+
+    const char *p = value;
+    if (!parse_int(&p, &out->x) || !parse_int(&p, &out->y) || !parse_int(&p, &out->w) || !parse_int(&p, &out->h)) {
+        return false;
+    }
+    out->alpha = -1;
+    if (parse_int(&p, &out->alpha)) {
+        if (out->alpha < 0) out->alpha = -1;
+        else if (out->alpha > DCLIGHT_ALPHA_MAX) out->alpha = DCLIGHT_ALPHA_MAX;
+    }
+
+    // 裁剪到屏幕内
+    s32 x1 = out->x + out->w, y1 = out->y + out->h;
+    if (out->x < 0) out->x = 0;
+    if (out->y < 0) out->y = 0;
+    if (x1 > SCREEN_WIDTH) x1 = SCREEN_WIDTH;
+    if (y1 > SCREEN_HEIGHT) y1 = SCREEN_HEIGHT;
+    out->w = x1 - out->x;
+    out->h = y1 - out->y;
+    return out->w > 0 && out->h > 0;
+}
+
+void regions_init(ViDisplay *display, s32 z) {
+    g_display = display;
+    g_layerZ = z;
+}
+
+static void region_release(RegionSlot *slot) {
+    dim_layer_destroy(&slot->layer);
+    slot->used = false;
+    g_active--;
+}
+
+void regions_exit(void) {
+    for (u32 i = 0; i < DIM_REGION_MAX; ++i) {
+        if (g_slots[i].used) region_release(&g_slots[i]);
+    }
+    g_display = NULL;
+}
+
+static const DimRegion *find_region(const DimRegionList *list, const char *name) {
+    for (u32 i = 0; i < list->count; ++i) {
+        if (strcmp(list->items[i].name, name) == 0) return &list->items[i];
+    }
+    return NULL;
+}
+
+static RegionSlot *find_slot(const char *name) {
+    for (u32 i = 0; i < DIM_REGION_MAX; ++i) {
+        if (g_slots[i].used && strcmp(g_slots[i].region.name, name) == 0) return &g_slots[i];
+    }
+    return NULL;
+}
+
+void regions_apply(const DimRegionList *list) {
+    if (g_display == NULL) return;
+
+    // 先销毁去掉的区域，腾出槽位
+    for (u32 i = 0; i < DIM_REGION_MAX; ++i) {
+        if (g_slots[i].used && find_region(list, g_slots[i].region.name) == NULL) {
+            log_info("区域 %s: 销毁图层", g_slots[i].region.name);
+            region_release(&g_slots[i]);
+        }
+    }
+
+    for (u32 i = 0; i < list->count; ++i) {
+        const DimRegion *region = &list->items[i];
+        RegionSlot *slot = find_slot(region->name);
+        if (slot) {
+            const DimRegion *old = &slot->region;
+            if (old->x != region->x || old->y != region->y || old->w != region->w || old->h != region->h) {
+                Result rc = dim_layer_set_rect(&slot->layer, region->x, region->y, region->w, region->h);
+                if (R_FAILED(rc)) log_error("区域 %s: 调整图层失败: 0x%x", region->name, rc);
+            }
+            if (old->alpha != region->alpha) slot->layer.presentedAlpha = -1;
+            slot->region = *region;
+            continue;
+        }
+
+        for (u32 s = 0; s < DIM_REGION_MAX && slot == NULL; ++s) {
+            if (!g_slots[s].used) slot = &g_slots[s];
+        }
+        if (slot == NULL) break;
+        Result rc = dim_layer_create(&slot->layer, g_display, g_layerZ, region->x, region->y, region->w, region->h);
+        if (R_FAILED(rc)) {
+            log_error("区域 %s: 创建图层失败: 0x%x", region->name, rc);
+            continue;
+        }
+        slot->region = *region;
+        slot->used = true;
+        g_active++;
+        log_info("区域 %s: (%d,%d) %dx%d alpha=%d", region->name, region->x, region->y, region->w, region->h, region->alpha);
+    }
+}
+
+bool regions_active(void) {
+    return g_active > 0;
+}
+
+void regions_resume(void) {
+    for (u32 i = 0; i < DIM_REGION_MAX; ++i) {
+        RegionSlot *slot = &g_slots[i];
+        if (!slot->used) continue;
+        Result rc = layer_show(&slot->layer.layer);
+        if (R_FAILED(rc)) log_debug("区域 %s: 重新加入图层栈: 0x%x", slot->region.name, rc);
+        slot->layer.presentedAlpha = -1;
+    }
+}
+
+u32 regions_present(u8 alpha) {
+    u32 presented = 0;
+    for (u32 i = 0; i < DIM_REGION_MAX; ++i) {
+        RegionSlot *slot = &g_slots[i];
+        if (!slot->used) continue;
+        if (dim_layer_present(&slot->layer, slot->region.alpha >= 0 ? (u8)slot->region.alpha : alpha)) presented++;
+    }
+    return presented;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// 区域暗化：config.ini 的 [regions] 节，每行 名称=x,y,w,h[,alpha]（1920x1080 屏幕坐标），
+// 每个区域是一个独立的小图层（1x1 帧缓冲由合成器放大），只暗化这些区域时全屏图层从图层栈中移除
+// 省略 alpha 的区域跟随当前暗化等级（包括过渡），指定 alpha 的区域固定不变
+#include <switch.h>
+
+#define DIM_REGION_MAX      8
+#define DIM_REGION_NAME_MAX 16
+
+#define DIM_REGION_SECTION "regions"
+
+typedef struct {
+    char name[DIM_REGION_NAME_MAX];
+    s32 x, y, w, h;
+    s32 alpha; // 0-15，-1 表示跟随当前暗化等级
+} DimRegion;
+
+typedef struct {
+    DimRegion items[DIM_REGION_MAX];
+    u32 count;
+} DimRegionList;
+
+// 解析 "x,y,w,h[,alpha]"，裁剪到屏幕内；无效或为空时返回 false
+bool dim_region_parse(const char *name, const char *value, DimRegion *out);
+
+void regions_init(ViDisplay *display, s32 z);
+void regions_exit(void);
+
+// 按新的区域列表增量更新图层：同名区域只调整位置和尺寸，新增的创建，去掉的销毁
+void regions_apply(const DimRegionList *list);
+
+// 是否有区域图层（此时全屏图层不参与合成）
+bool regions_active(void);
+
+// 主机醒来后重新把各区域图层加入图层栈，下一次 regions_present 时全部重新提交
+void regions_resume(void);
+
+// 提交各区域的 alpha；跟随暗化等级的区域使用 alpha，每个图层只在值变化时提交
+// 返回实际提交的图层数
+u32 regions_present(u8 alpha);
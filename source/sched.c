@@ -0,0 +1,81 @@
+// 主循环调度器
+#include "sched.h"
+#include "metrics.h"
+
+static Waiter g_waiters[SchedWaiter_Count];
+static bool g_waiterActive[SchedWaiter_Count];
+static u64 g_timerDeadline[SchedTimer_Count]; // 系统 tick，0 表示未设置
+
+void sched_init(void) {
+    for (int i = 0; i < SchedWaiter_Count; ++i) g_waiterActive[i] = false;
+    for (int i = 0; i < SchedTimer_Count; ++i) g_timerDeadline[i] = 0;
+}
+
+void sched_set_waiter(SchedWaiterId id, Waiter waiter) {
+    g_waiters[id] = waiter;
+    g_waiterActive[id] = true;
+}
+
+void sched_clear_waiter(SchedWaiterId id) {
+    g_waiterActive[id] = false;
+}
+
+void sched_timer_arm(SchedTimerId id, u64 ns) {
+    u64 deadline = armGetSystemTick() + armNsToTicks(ns);
+    if (deadline == 0) deadline = 1;
+    if (g_timerDeadline[id] == 0 || deadline < g_timerDeadline[id]) {
+        g_timerDeadline[id] = deadline;
+    }
+}
+
+void sched_timer_cancel(SchedTimerId id) {
+    g_timerDeadline[id] = 0;
+}
+
+bool sched_timer_armed(SchedTimerId id) {
+    return g_timerDeadline[id] != 0;
+}
+
+u32 sched_wait(void) {
+    Waiter waiters[SchedWaiter_Count];
+    SchedWaiterId ids[SchedWaiter_Count];
+    s32 count = 0;
+    for (int i = 0; i < SchedWaiter_Count; ++i) {
+        if (!g_waiterActive[i]) continue;
+        waiters[count] = g_waiters[i];
+        ids[count] = (SchedWaiterId)i;
+        count++;
+    }
+
+    u64 nearest = UINT64_MAX;
+    for (int i = 0; i < SchedTimer_Count; ++i) {
+        if (g_timerDeadline[i] != 0 && g_timerDeadline[i] < nearest) nearest = g_timerDeadline[i];
+    }
+
+    u64 timeout = UINT64_MAX;
+    if (nearest != UINT64_MAX) {
+        u64 now = armGetSystemTick();
+        timeout = nearest > now ? armTicksToNs(nearest - now) : 0;
+    }
+
+    u32 fired = 0;
+    if (count > 0) {
+        s32 idx = -1;
+        Result rc = waitObjects(&idx, waiters, count, timeout);
+        if (R_SUCCEEDED(rc) && idx >= 0 && idx < count) {
+            fired |= SCHED_EVENT_WAITER(ids[idx]);
+        }
+    } else if (timeout != UINT64_MAX) {
+        svcSleepThread((s64)timeout);
+    }
+    metrics_count(MetricCount_Wakeup);
+
+    u64 now = armGetSystemTick();
+    for (int i = 0; i < SchedTimer_Count; ++i) {
+        if (g_timerDeadline[i] != 0 && g_timerDeadline[i] <= now) {
+            g_timerDeadline[i] = 0;
+            fired |= SCHED_EVENT_TIMER(i);
+        }
+    }
+    return fired;
+}
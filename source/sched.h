@@ -0,0 +1,44 @@
+#pragma once
+
+// 主循环调度器：在一组等待对象和若干截止时间上阻塞（waitObjects），
+// 没有任何定时器时无限期休眠，直到有事件到达
+#include <switch.h>
+
+// 等待对象：被触发时立即唤醒主循环
+typedef enum {
+    SchedWaiter_Wake,    // IPC 请求（UEvent）
+    SchedWaiter_Mailbox, // 共享内存信箱 doorbell
+    SchedWaiter_Vsync,   // 显示 vsync，仅在亮度过渡期间加入
+    SchedWaiter_Power,   // PSC 电源状态变化（睡眠、醒来、关机）
+    SchedWaiter_Title,   // pm:shell 进程事件，仅在配置了 [title_<id>] 节时加入
+    SchedWaiter_Count,
+} SchedWaiterId;
+
+// 定时器：到达截止时间时唤醒主循环，单次触发，需要时由调用者重新设置
+typedef enum {
+    SchedTimer_Transition,   // 亮度过渡的下一步
+    SchedTimer_ConfigPoll,   // 周期检查 config.ini（config_poll_ms，0 表示不轮询）
+    SchedTimer_ConfigSettle, // 检测到变化后，在时间戳稳定前继续检查
+    SchedTimer_TitlePoll,    // 检查前台应用：进程事件之后，或兜底/无事件时的轮询（仅在配置了 [title_<id>] 节时）
+    SchedTimer_Schedule,     // 亮度计划的下一次变化（[schedule] 节）
+    SchedTimer_Hotkey,       // 采样快捷键（仅在配置了 hotkey 且修饰键未按住时）
+    SchedTimer_HotkeySave,   // 快捷键调节停止一段时间后保存亮度
+    SchedTimer_Indicator,    // 隐藏亮度指示器
+    SchedTimer_Count,
+} SchedTimerId;
+
+#define SCHED_EVENT_WAITER(id) BIT(id)
+#define SCHED_EVENT_TIMER(id)  BIT(16 + (id))
+
+void sched_init(void);
+
+void sched_set_waiter(SchedWaiterId id, Waiter waiter);
+void sched_clear_waiter(SchedWaiterId id);
+
+// 在 ns 纳秒后触发；已设置时取较早的截止时间
+void sched_timer_arm(SchedTimerId id, u64 ns);
+void sched_timer_cancel(SchedTimerId id);
+bool sched_timer_armed(SchedTimerId id);
+
+// 阻塞到任一等待对象触发或最早的定时器到期，返回 SCHED_EVENT_* 位掩码
+u32 sched_wait(void);
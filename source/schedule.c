@@ -0,0 +1,120 @@
+// 按时间的亮度计划
+// 点按时间有序存放（插入时保持有序），查询时找出 second 所在的区间 [a, b)：
+// a 是不晚于 second 的最后一个点（没有则为前一天的最后一个点），b 是它之后的点
+#include <dclight/ipc.h>
+#include "schedule.h"
+
+typedef struct {
+    const SchedulePoint *from;
+    const SchedulePoint *to;
+    u32 offset; // second 距 from 的秒数
+    u32 length; // from 到 to 的秒数（只有一个点时为一整天）
+} ScheduleSegment;
+
+void schedule_reset(Schedule *schedule) {
+    schedule->count = 0;
+    schedule->interpolate = false;
+}
+
+static bool parse_digits(const char **p, u32 *out) {
+    u32 v = 0;
+    int n = 0;
+    while (**p >= '0' && **p <= '9' && n < 2) {
+        v = v * 10 + (u32)(**p - '0');
+        ++*p;
+        ++n;
+    }
+    *out = v;
+    return n > 0;
+}
+
+bool schedule_parse_time(const char *text, u32 *out_second) {
+    const char *p = text;
+    u32 hour, minute;
+    if (!parse_digits(&p, &hour) || *p++ != ':') return false;
+    if (!parse_digits(&p, &minute) || *p != '\0') return false;
+    if (hour > 23 || minute > 59) return false;
+    *out_second = hour * 3600 + minute * 60;
+    return true;
+}
+
+bool schedule_add(Schedule *schedule, u32 second, s32 brightness) {
+    u32 i = schedule->count;
+    while (i > 0 && schedule->points[i - 1].second > second) --i;
+    if (i > 0 && schedule->points[i - 1].second == second) return true;
+    if (schedule->count >= SCHEDULE_MAX_POINTS) return false;
+
+    for (u32 j = schedule->count; j > i; --j) {
+        schedule->points[j] = schedule->points[j - 1];
+    }
+    schedule->points[i].second = second;
+    schedule->points[i].brightness = brightness;
+    schedule->count++;
+    return true;
+}
+
+static ScheduleSegment schedule_segment(const Schedule *schedule, u32 second) {
+    u32 n = schedule->count;
+    u32 i = 0;
+    while (i < n && schedule->points[i].second <= second) ++i;
+    // i 为第一个晚于 second 的点
+    const SchedulePoint *from = &schedule->points[(i + n - 1) % n];
+    const SchedulePoint *to = &schedule->points[i % n];
+
+    ScheduleSegment seg = { from, to };
+    seg.offset = (second + SCHEDULE_DAY_SECONDS - from->second) % SCHEDULE_DAY_SECONDS;
+    seg.length = (to->second + SCHEDULE_DAY_SECONDS - from->second) % SCHEDULE_DAY_SECONDS;
+    if (seg.length == 0) seg.length = SCHEDULE_DAY_SECONDS;
+    return seg;
+}
+
+// 区间内 offset 处的亮度；线性插值对 offset 单调，因此 alpha 也单调
+static s32 segment_brightness(const Schedule *schedule, const ScheduleSegment *seg, u32 offset) {
+    if (!schedule->interpolate) return seg->from->brightness;
+    s64 delta = (s64)seg->to->brightness - seg->from->brightness;
+    return seg->from->brightness + (s32)(delta * offset / seg->length);
+}
+
+static u32 brightness_alpha(s32 brightness, bool alpha8) {
+    return alpha8 ? dclightBrightnessToAlpha8((u32)brightness) : dclightBrightnessToAlpha((u32)brightness);
+}
+
+static u32 segment_alpha(const Schedule *schedule, const ScheduleSegment *seg, u32 offset, bool alpha8) {
+    return brightness_alpha(segment_brightness(schedule, seg, offset), alpha8);
+}
+
+s32 schedule_brightness_at(const Schedule *schedule, u32 second) {
+    if (schedule->count == 0) return -1;
+    ScheduleSegment seg = schedule_segment(schedule, second % SCHEDULE_DAY_SECONDS);
+    return segment_brightness(schedule, &seg, seg.offset);
+}
+
+u32 schedule_next_change(const Schedule *schedule, u32 second, bool alpha8) {
+    if (schedule->count == 0) return 0;
+    second %= SCHEDULE_DAY_SECONDS;
+
+    // 一整天都不变（只有一个点，或所有点的 alpha 相同）时不需要醒来
+    u32 first = brightness_alpha(schedule->points[0].brightness, alpha8);
+    bool constant = true;
+    for (u32 i = 1; i < schedule->count && constant; ++i) {
+        constant = brightness_alpha(schedule->points[i].brightness, alpha8) == first;
+    }
+    if (constant) return 0;
+
+    ScheduleSegment seg = schedule_segment(schedule, second);
+    u32 now = segment_alpha(schedule, &seg, seg.offset, alpha8);
+    u32 end = brightness_alpha(seg.to->brightness, alpha8);
+    if (!schedule->interpolate || end == now) {
+        // 阶跃：到下一个点；插值区间内不变：到区间终点再重新计算
+        return seg.length - seg.offset;
+    }
+
+    // 二分查找区间内 alpha 第一次不同于当前值的时刻
+    u32 lo = seg.offset, hi = seg.length; // alpha(lo) == now, alpha(hi) != now
+    while (hi - lo > 1) {
+        u32 mid = lo + (hi - lo) / 2;
+        if (segment_alpha(schedule, &seg, mid, alpha8) == now) lo = mid;
+        else hi = mid;
+    }
+    return hi - seg.offset;
+}
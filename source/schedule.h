@@ -0,0 +1,37 @@
+#pragma once
+
+// 按时间的亮度计划：config.ini 的 [schedule] 节，每行 HH:MM=亮度(0-100)，
+// interpolate=1 时在相邻两点之间线性过渡（跨过午夜首尾相接）
+// 配置变化时整理成按时间排序的表，并计算暗化 alpha 下一次变化的时刻，主循环只在那时醒来
+// （与平台无关：sysmodule 和宿主工具共用）
+#include <switch/types.h>
+
+#define SCHEDULE_SECTION     "schedule"
+#define SCHEDULE_MAX_POINTS  48
+#define SCHEDULE_DAY_SECONDS 86400
+
+typedef struct {
+    u32 second;     // 当天的第几秒
+    s32 brightness; // 0-100
+} SchedulePoint;
+
+typedef struct {
+    SchedulePoint points[SCHEDULE_MAX_POINTS];
+    u32 count;       // 0 表示未启用
+    bool interpolate;
+} Schedule;
+
+void schedule_reset(Schedule *schedule);
+
+// 解析 "HH:MM"（00:00-23:59）
+bool schedule_parse_time(const char *text, u32 *out_second);
+
+// 添加一个点；同一时刻重复出现时以第一次为准，超过 SCHEDULE_MAX_POINTS 时返回 false
+bool schedule_add(Schedule *schedule, u32 second, s32 brightness);
+
+// 在 second（当天的第几秒）时的亮度；未启用时返回 -1
+s32 schedule_brightness_at(const Schedule *schedule, u32 second);
+
+// 从 second 起到暗化 alpha 下一次变化还有多少秒（至少 1）；永远不变时返回 0。
+// alpha8 为真时按实际绘制的 0-255 alpha 计算（RGBA8888 均匀暗化），否则按 0-15
+u32 schedule_next_change(const Schedule *schedule, u32 second, bool alpha8);
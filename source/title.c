@@ -0,0 +1,72 @@
+// 前台应用监视
+#include "title.h"
+#include "profile.h"
+#include "metrics.h"
+
+static bool g_ready = false;
+static bool g_eventReady = false;
+static Event g_processEvent;
+static u64 g_pid = 0;                    // 0 表示没有运行应用
+static u64 g_titleId = TITLE_ID_HOME_MENU;
+
+Result title_monitor_init(void) {
+    Result rc = pmdmntInitialize();
+    if (R_FAILED(rc)) return rc;
+    rc = pminfoInitialize();
+    if (R_FAILED(rc)) {
+        pmdmntExit();
+        return rc;
+    }
+    g_pid = 0;
+    g_titleId = TITLE_ID_HOME_MENU;
+    g_ready = true;
+
+    // 没有进程事件时仍可轮询
+    if (R_SUCCEEDED(pmshellInitialize())) {
+        if (R_SUCCEEDED(pmshellGetProcessEventHandle(&g_processEvent))) {
+            g_eventReady = true;
+        } else {
+            pmshellExit();
+        }
+    }
+    return 0;
+}
+
+void title_monitor_exit(void) {
+    if (!g_ready) return;
+    if (g_eventReady) {
+        eventClose(&g_processEvent);
+        pmshellExit();
+        g_eventReady = false;
+    }
+    pminfoExit();
+    pmdmntExit();
+    g_ready = false;
+}
+
+Event *title_monitor_event(void) {
+    return g_eventReady ? &g_processEvent : NULL;
+}
+
+bool title_monitor_poll(u64 *out_title_id) {
+    if (g_ready) {
+        u64 pid = 0;
+        if (R_FAILED(pmdmntGetApplicationProcessId(&pid))) pid = 0;
+        metrics_count(MetricCount_TitlePoll);
+
+        if (pid != g_pid) {
+            u64 titleId = TITLE_ID_HOME_MENU;
+            if (pid != 0 && R_FAILED(pminfoGetProgramId(&titleId, pid))) {
+                titleId = TITLE_ID_HOME_MENU;
+            }
+            g_pid = pid;
+            if (titleId != g_titleId) {
+                g_titleId = titleId;
+                *out_title_id = g_titleId;
+                return true;
+            }
+        }
+    }
+    *out_title_id = g_titleId;
+    return false;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// 前台应用监视
+// pm:shell 的进程事件在任何进程创建、启动或退出时触发，主循环把它作为等待对象，醒来后调用 title_monitor_poll：
+// 只查询前台应用的进程 ID（一次 IPC，不访问 SD 卡），进程变化时才查询 program ID。
+// 事件和 am 共用，由 am 调用 GetProcessEventInfo 取走并复位；这里既不取事件信息也不复位，
+// 醒来后把事件移出等待集合 TITLE_SETTLE_NS，到时再查询并重新加入，am 来不及复位时也不会空转
+#include <switch.h>
+
+// 事件触发到查询之间的间隔
+#define TITLE_SETTLE_NS 200000000ULL
+// 有进程事件时的兜底查询间隔（错过事件时最迟在这之后纠正）
+#define TITLE_BACKSTOP_NS 60000000000ULL
+// 拿不到进程事件时的查询间隔；没有配置任何应用时不需要查询
+#define TITLE_POLL_NS 1000000000ULL
+
+Result title_monitor_init(void);
+void title_monitor_exit(void);
+
+// pm:shell 的进程事件，拿不到时为 NULL（改为按 TITLE_POLL_NS 轮询）
+Event *title_monitor_event(void);
+
+// 检查前台应用是否变化；变化时返回 true。*out_title_id 总是当前应用的 title ID，
+// 没有运行应用时为 TITLE_ID_HOME_MENU
+bool title_monitor_poll(u64 *out_title_id);
@@ -1,84 +1,299 @@
-
+// 异步日志
+// 环形缓冲区是多生产者/单消费者的有界队列：生产者用 CAS 领取槽位、写入后发布序号，
+// 写日志线程按顺序取走已发布的槽位。每个槽位的 seq 为 2*圈数 表示空闲、2*圈数+1 表示已写入，
+// 全零即初始状态，因此在 log_init 之前（__appInit 中）也可以直接记录
 #include <stdio.h>
 #include "log.h"
+#include "metrics.h"
 #include <stdarg.h>
 #include <string.h>
 #include <switch/services/time.h>
 #include <time.h>
 #include <switch.h>
 
+#define LOG_FILE_PATH "/atmosphere/logs/test.log"
+
+// 槽位数（2 的幂）和每条消息正文的最大长度，超出部分截断
+#ifndef LOG_RING_SLOTS
+#  ifdef DCLIGHT_LEAN
+#    define LOG_RING_SLOTS 32
+#  else
+#    define LOG_RING_SLOTS 64
+#  endif
+#endif
+#define LOG_TEXT_SIZE 200
+
+// 有消息时最多缓存这么久再写出；积压到一半槽位时立即写出
+#define LOG_FLUSH_INTERVAL_NS 2000000000ULL
+#define LOG_FLUSH_THRESHOLD   (LOG_RING_SLOTS / 2)
+
+// 连续重复的消息只写一次，之后写 "上一条消息重复了 N 次"；
+// 重复一直持续时至少每隔这么久报告一次
+#define LOG_REPEAT_REPORT_NS  600000000000ULL
+
+#define LOG_THREAD_STACK_SIZE 0x3000
+#define LOG_THREAD_PRIORITY   0x3F
+
+typedef enum {
+    LogLevel_Info,
+    LogLevel_Warning,
+    LogLevel_Error,
+    LogLevel_Debug,
+} LogLevel;
+
+static const char *const g_levelNames[] = { "INFO", "WARNING", "ERROR", "DEBUG" };
+
+typedef struct {
+    u64 seq;
+    u64 tick;          // armGetSystemTick，写出时再换算成本地时间
+    const char *file;  // __FILE__，静态存储
+    u32 line;
+    u32 level;
+    char text[LOG_TEXT_SIZE];
+} LogSlot;
+
+static LogSlot g_ring[LOG_RING_SLOTS];
+static u64 g_head = 0;    // 下一个要领取的位置
+static u64 g_tail = 0;    // 下一个要写出的位置（只由持有 log_mutex 的一方修改）
+static u32 g_dropped = 0; // 缓冲区满时丢弃的消息数
 
 static Mutex log_mutex = 0;
-#define LOG_FILE_PATH "/atmosphere/logs/test.log"
 static FILE *log_file = NULL;
 
-static char *cur_time() {
-    u64 timestamp = 0;
-    timeGetCurrentTime(TimeType_LocalSystemClock, &timestamp);
-    // Convert to UTC+8 by adding 8*3600 seconds
+// 最近写出的一条消息及其后被合并的重复次数（只由持有 log_mutex 的一方访问）
+static LogSlot g_last;
+static u32 g_repeats = 0;
+static u64 g_repeatTick = 0; // 第一次重复的 tick
+
+static UEvent g_flushEvent;
+static Thread g_thread;
+static bool g_threadRunning = false;
+static bool g_stopping = false;
+
+static void log_push(LogLevel level, const char *file, int line, const char *fmt, va_list args) {
+    u64 pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+    LogSlot *slot;
+    for (;;) {
+        slot = &g_ring[pos % LOG_RING_SLOTS];
+        u64 empty = 2 * (pos / LOG_RING_SLOTS);
+        u64 seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq == empty) {
+            if (__atomic_compare_exchange_n(&g_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if ((s64)(seq - empty) < 0) {
+            // 上一圈的消息还没写出：缓冲区已满
+            __atomic_add_fetch(&g_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->tick = armGetSystemTick();
+    slot->file = file;
+    slot->line = (u32)line;
+    slot->level = level;
+    vsnprintf(slot->text, sizeof(slot->text), fmt, args);
+    // 发布之前 g_tail 不会越过 pos
+    u64 pending = pos - __atomic_load_n(&g_tail, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->seq, 2 * (pos / LOG_RING_SLOTS) + 1, __ATOMIC_RELEASE);
+
+    // 只在缓冲区由空变为非空、或积压达到阈值时唤醒写日志线程
+    if (__atomic_load_n(&g_threadRunning, __ATOMIC_ACQUIRE)) {
+        if (pending == 0 || pending + 1 == LOG_FLUSH_THRESHOLD) ueventSignal(&g_flushEvent);
+    }
+}
+
+static void format_time(char *buf, size_t size, u64 timestamp) {
+    // 换算为 UTC+8
     time_t t = (time_t)timestamp + 8 * 3600;
-    struct tm *tm_ptr = gmtime(&t);
-    int hours = tm_ptr->tm_hour;
-    int minutes = tm_ptr->tm_min;
-    int seconds = tm_ptr->tm_sec;
-    int day = tm_ptr->tm_mday;
-    int month = tm_ptr->tm_mon;
-    int year = tm_ptr->tm_year + 1900;
-    // Format time as "YYYY-MM-DD HH:MM:SS"
-    static char timebuf[64];
-    snprintf(timebuf, sizeof(timebuf), "%04i-%02i-%02i %02i:%02i:%02i",
-             year, month + 1, day, hours, minutes, seconds);
-    return timebuf;
-}
-
-static void log_write(const char *level, const char *file, int line, const char *fmt, va_list args) {
-    mutexLock(&log_mutex);
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    snprintf(buf, size, "%04i-%02i-%02i %02i:%02i:%02i",
+             tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+// 一条消息的时间：有本地时间时由本批查询的时间和 tick 差推算；
+// time 服务尚未初始化（log_init 早于 timeInitialize）或不可用时改记开机后的时间
+static void format_stamp(char *buf, size_t size, bool clock, u64 now, u64 nowTick, u64 tick) {
+    if (!clock) {
+        u64 ms = armTicksToNs(tick) / 1000000ULL;
+        snprintf(buf, size, "boot+%lu.%03lus", ms / 1000, ms % 1000);
+        return;
+    }
+    u64 age = armTicksToNs(nowTick - tick) / 1000000000ULL;
+    format_time(buf, size, now > age ? now - age : 0);
+}
+
+static bool log_same_message(const LogSlot *a, const LogSlot *b) {
+    return a->file == b->file && a->line == b->line && a->level == b->level && strcmp(a->text, b->text) == 0;
+}
+
+static void log_write_repeats(const char *timebuf) {
+    if (g_repeats == 0) return;
+    fprintf(log_file, "%s [log] [%s] 上一条消息重复了 %u 次\n", timebuf, g_levelNames[g_last.level], g_repeats);
+    g_repeats = 0;
+}
+
+// 取走所有已发布的消息并写入文件；调用者持有 log_mutex
+static void log_drain_locked(bool final) {
     if (!log_file) {
         log_file = fopen(LOG_FILE_PATH, "a");
-        if (!log_file) {
-            mutexUnlock(&log_mutex);
-            return;
+        if (!log_file) return;
+    }
+
+    // 每批只查询一次时钟，各条消息的时间由 tick 差推算
+    u64 nowTick = armGetSystemTick();
+    u64 now = 0;
+    bool clock = R_SUCCEEDED(timeGetCurrentTime(TimeType_LocalSystemClock, &now)) && now != 0;
+
+    bool wrote = false;
+    char timebuf[32];
+    for (;;) {
+        u64 pos = g_tail;
+        LogSlot *slot = &g_ring[pos % LOG_RING_SLOTS];
+        u64 used = 2 * (pos / LOG_RING_SLOTS) + 1;
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != used) break;
+
+        if (g_last.file != NULL && log_same_message(slot, &g_last)) {
+            if (g_repeats++ == 0) g_repeatTick = slot->tick;
+            __atomic_store_n(&slot->seq, used + 1, __ATOMIC_RELEASE);
+            __atomic_store_n(&g_tail, pos + 1, __ATOMIC_RELAXED);
+            continue;
         }
+
+        format_stamp(timebuf, sizeof(timebuf), clock, now, nowTick, slot->tick);
+        log_write_repeats(timebuf);
+        // 只打印file名最后20个字符
+        const char *short_file = slot->file;
+        size_t file_len = strlen(short_file);
+        if (file_len > 20) {
+            short_file += file_len - 20;
+        }
+        fprintf(log_file, "%s [%s:%u] [%s] %s\n", timebuf, short_file, slot->line, g_levelNames[slot->level], slot->text);
+        wrote = true;
+
+        memcpy(&g_last, slot, sizeof(g_last));
+        __atomic_store_n(&slot->seq, used + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&g_tail, pos + 1, __ATOMIC_RELAXED);
     }
-    // 只打印file名最后20个字符
-    const char *short_file = file;
-    size_t file_len = strlen(file);
-    if (file_len > 20) {
-        short_file = file + file_len - 20;
+
+    if (g_repeats > 0 && (final || armTicksToNs(nowTick - g_repeatTick) >= LOG_REPEAT_REPORT_NS)) {
+        format_stamp(timebuf, sizeof(timebuf), clock, now, nowTick, nowTick);
+        log_write_repeats(timebuf);
+        wrote = true;
+    }
+
+    u32 dropped = __atomic_exchange_n(&g_dropped, 0, __ATOMIC_RELAXED);
+    if (dropped > 0) {
+        format_stamp(timebuf, sizeof(timebuf), clock, now, nowTick, nowTick);
+        fprintf(log_file, "%s [log] [WARNING] 日志缓冲区已满，丢弃了 %u 条消息\n", timebuf, dropped);
+        wrote = true;
     }
-    fprintf(log_file, "%s [%s:%d] [%s] ", cur_time(), short_file, line, level);
-    vfprintf(log_file, fmt, args);
-    fprintf(log_file, "\n");
-    fflush(log_file);
+
+    if (wrote) {
+        fflush(log_file);
+        metrics_count(MetricCount_LogWrite);
+    }
+}
+
+void log_flush(void) {
+    mutexLock(&log_mutex);
+    log_drain_locked(false);
     mutexUnlock(&log_mutex);
 }
 
+bool log_ratelimit(LogRateLimit *rl, u64 interval_ns, u32 *out_suppressed) {
+    // 多个线程同时到达时可能多放过一条，不影响限速效果
+    u64 now = armGetSystemTick();
+    u64 next = __atomic_load_n(&rl->next_tick, __ATOMIC_RELAXED);
+    if (next != 0 && now < next) {
+        __atomic_add_fetch(&rl->suppressed, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    __atomic_store_n(&rl->next_tick, now + armNsToTicks(interval_ns), __ATOMIC_RELAXED);
+    *out_suppressed = __atomic_exchange_n(&rl->suppressed, 0, __ATOMIC_RELAXED);
+    return true;
+}
 
+static bool log_pending(void) {
+    return __atomic_load_n(&g_head, __ATOMIC_RELAXED) != __atomic_load_n(&g_tail, __ATOMIC_RELAXED)
+        || __atomic_load_n(&g_dropped, __ATOMIC_RELAXED) != 0;
+}
+
+static void log_thread(void *arg) {
+    while (!__atomic_load_n(&g_stopping, __ATOMIC_ACQUIRE)) {
+        // 没有消息时无限期休眠；第一条消息到达后再攒一段时间，积压到阈值或退出时提前写出
+        if (!log_pending()) {
+            waitSingle(waiterForUEvent(&g_flushEvent), UINT64_MAX);
+            continue;
+        }
+        waitSingle(waiterForUEvent(&g_flushEvent), LOG_FLUSH_INTERVAL_NS);
+        log_flush();
+    }
+}
+
+void log_init(void) {
+    if (g_threadRunning) return;
+
+    ueventCreate(&g_flushEvent, true);
+    __atomic_store_n(&g_stopping, false, __ATOMIC_RELEASE);
+    Result rc = threadCreate(&g_thread, log_thread, NULL, NULL, LOG_THREAD_STACK_SIZE, LOG_THREAD_PRIORITY, -2);
+    if (R_FAILED(rc)) {
+        // 没有写日志线程时只在 log_flush/log_exit 时写出
+        return;
+    }
+    rc = threadStart(&g_thread);
+    if (R_FAILED(rc)) {
+        threadClose(&g_thread);
+        return;
+    }
+    __atomic_store_n(&g_threadRunning, true, __ATOMIC_RELEASE);
+    // 写出 log_init 之前缓存的消息
+    ueventSignal(&g_flushEvent);
+}
+
+void log_exit(void) {
+    if (__atomic_load_n(&g_threadRunning, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&g_stopping, true, __ATOMIC_RELEASE);
+        ueventSignal(&g_flushEvent);
+        threadWaitForExit(&g_thread);
+        threadClose(&g_thread);
+        __atomic_store_n(&g_threadRunning, false, __ATOMIC_RELEASE);
+    }
+
+    mutexLock(&log_mutex);
+    log_drain_locked(true);
+    if (log_file) {
+        fclose(log_file);
+        log_file = NULL;
+    }
+    mutexUnlock(&log_mutex);
+}
 
 void log_info_impl(const char *file, int line, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    log_write("INFO", file, line, fmt, args);
+    log_push(LogLevel_Info, file, line, fmt, args);
     va_end(args);
 }
 
 void log_warning_impl(const char *file, int line, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    log_write("WARNING", file, line, fmt, args);
+    log_push(LogLevel_Warning, file, line, fmt, args);
     va_end(args);
 }
 
 void log_error_impl(const char *file, int line, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    log_write("ERROR", file, line, fmt, args);
+    log_push(LogLevel_Error, file, line, fmt, args);
     va_end(args);
 }
 
 void log_debug_impl(const char *file, int line, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    log_write("DEBUG", file, line, fmt, args);
+    log_push(LogLevel_Debug, file, line, fmt, args);
     va_end(args);
-}
\ No newline at end of file
+}
@@ -1,11 +1,68 @@
+#pragma once
 
+// 日志：调用方只把消息格式化进内存环形缓冲区（无锁，不访问 SD 卡），
+// 由低优先级线程按数量/时间阈值批量写入 LOG_FILE_PATH
+#include <switch.h>
 
-void log_info_impl(const char *file, int line, const char *fmt, ...);
-void log_warning_impl(const char *file, int line, const char *fmt, ...);
-void log_error_impl(const char *file, int line, const char *fmt, ...);
-void log_debug_impl(const char *file, int line, const char *fmt, ...);
+// 日志等级；低于 DCLIGHT_LOG_LEVEL 的 log_* 调用在编译期被整个去掉（make LOG_LEVEL=...）
+#define LOG_LEVEL_DEBUG   0
+#define LOG_LEVEL_INFO    1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR   3
+#define LOG_LEVEL_NONE    4
 
-#define log_info(fmt, ...)    log_info_impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define log_warning(fmt, ...) log_warning_impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define log_error(fmt, ...)   log_error_impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define log_debug(fmt, ...)   log_debug_impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
\ No newline at end of file
+#ifndef DCLIGHT_LOG_LEVEL
+#  define DCLIGHT_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_ENABLED(level) (LOG_LEVEL_##level >= DCLIGHT_LOG_LEVEL)
+
+// 启动写日志线程（SD 卡挂载之后调用）；在此之前的消息会先缓存在环形缓冲区中
+void log_init(void);
+// 停止写日志线程并写出剩余消息（卸载 SD 卡之前调用）
+void log_exit(void);
+// 立即写出缓冲区中的消息
+void log_flush(void);
+
+void log_info_impl(const char *file, int line, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+void log_warning_impl(const char *file, int line, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+void log_error_impl(const char *file, int line, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+void log_debug_impl(const char *file, int line, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+// 关闭的等级仍保留在 if (0) 中，参数照常做类型检查，也不会产生未使用变量的警告
+#define LOG_CALL_(level, impl, fmt, ...) \
+    do { if (LOG_ENABLED(level)) impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__); } while (0)
+
+#define log_info(fmt, ...)    LOG_CALL_(INFO, log_info_impl, fmt, ##__VA_ARGS__)
+#define log_warning(fmt, ...) LOG_CALL_(WARNING, log_warning_impl, fmt, ##__VA_ARGS__)
+#define log_error(fmt, ...)   LOG_CALL_(ERROR, log_error_impl, fmt, ##__VA_ARGS__)
+#define log_debug(fmt, ...)   LOG_CALL_(DEBUG, log_debug_impl, fmt, ##__VA_ARGS__)
+
+// 调用点级别的限速：每个调用点 interval_ms 内最多记录一条，
+// 下一条被记录时附带期间省略的条数
+typedef struct {
+    u64 next_tick;
+    u32 suppressed;
+} LogRateLimit;
+
+// 返回 true 表示这次可以记录，*out_suppressed 为上次记录以来省略的条数
+bool log_ratelimit(LogRateLimit *rl, u64 interval_ns, u32 *out_suppressed);
+
+#define LOG_RATELIMITED_(level, impl, interval_ms, fmt, ...) \
+    do { \
+        if (LOG_ENABLED(level)) { \
+            static LogRateLimit log_rl_; \
+            u32 log_suppressed_; \
+            if (log_ratelimit(&log_rl_, (u64)(interval_ms) * 1000000ULL, &log_suppressed_)) { \
+                if (log_suppressed_ > 0) \
+                    impl(__FILE__, __LINE__, fmt " (省略了 %u 条)", ##__VA_ARGS__, log_suppressed_); \
+                else \
+                    impl(__FILE__, __LINE__, fmt, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define log_info_ratelimited(interval_ms, fmt, ...)    LOG_RATELIMITED_(INFO, log_info_impl, interval_ms, fmt, ##__VA_ARGS__)
+#define log_warning_ratelimited(interval_ms, fmt, ...) LOG_RATELIMITED_(WARNING, log_warning_impl, interval_ms, fmt, ##__VA_ARGS__)
+#define log_error_ratelimited(interval_ms, fmt, ...)   LOG_RATELIMITED_(ERROR, log_error_impl, interval_ms, fmt, ##__VA_ARGS__)
+#define log_debug_ratelimited(interval_ms, fmt, ...)   LOG_RATELIMITED_(DEBUG, log_debug_impl, interval_ms, fmt, ##__VA_ARGS__)